@@ -0,0 +1,231 @@
+# Generates a header with constexpr tables describing every feature of a
+# techniques.json, for builds that ship the catalog inside the binary
+# (CMT_EMBED_CATALOG). Runs at configure time; the JSON is registered as a
+# configure dependency so editing it regenerates the header.
+#
+# The derived fields (usage, syntax, notes) are formatted exactly like
+# TechniqueParser::fromJson so both paths show the same text.
+
+function(_cmt_raw_literal out text)
+    string(FIND "${text}" ")cmt\"" clash)
+    if(NOT clash EQUAL -1)
+        message(FATAL_ERROR "techniques.json contains the raw-string delimiter )cmt\"")
+    endif()
+    set(${out} "R\"cmt(${text})cmt\"" PARENT_SCOPE)
+endfunction()
+
+# Reads an optional string member; empty if missing or not a string.
+function(_cmt_json_string out json)
+    string(JSON type ERROR_VARIABLE err TYPE "${json}" ${ARGN})
+    if(err OR NOT type STREQUAL "STRING")
+        set(${out} "" PARENT_SCOPE)
+        return()
+    endif()
+    string(JSON value GET "${json}" ${ARGN})
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+# Emits a constexpr string_view array for a string list member and returns the
+# expression to use as its span (an empty span when the list is missing/empty).
+function(_cmt_json_list out_decl out_span out_joined json array_name member)
+    set(decl "")
+    set(span "std::span<const std::string_view>{}")
+    set(joined "")
+    string(JSON type ERROR_VARIABLE err TYPE "${json}" ${member})
+    if(NOT err AND type STREQUAL "ARRAY")
+        string(JSON count LENGTH "${json}" ${member})
+        set(joined "- ")
+        if(count GREATER 0)
+            math(EXPR last "${count} - 1")
+            set(items "")
+            foreach(i RANGE ${last})
+                string(JSON item GET "${json}" ${member} ${i})
+                _cmt_raw_literal(literal "${item}")
+                string(APPEND items "    ${literal},\n")
+                if(i EQUAL 0)
+                    set(joined "- ${item}")
+                else()
+                    string(APPEND joined "\n- ${item}")
+                endif()
+            endforeach()
+            set(decl "inline constexpr std::string_view ${array_name}[] = {\n${items}};\n")
+            set(span "std::span<const std::string_view>(${array_name})")
+        endif()
+    endif()
+    set(${out_decl} "${decl}" PARENT_SCOPE)
+    set(${out_span} "${span}" PARENT_SCOPE)
+    set(${out_joined} "${joined}" PARENT_SCOPE)
+endfunction()
+
+# Year of the first standard level named in text, like
+# TechniqueParser::standardYear: cpp17 -> 2017, cpp98 -> 1998, cpp2026 -> 2026,
+# provisional names 0x/1y/1z/2a/2b/2c -> 2011/2014/2017/2020/2023/2026; 0 if none.
+function(_cmt_standard_year out text)
+    set(year 0)
+    if(text MATCHES "^[^0-9]*([0-9])([A-Za-z])")
+        set(decade "${CMAKE_MATCH_1}")
+        string(TOLOWER "${CMAKE_MATCH_2}" letter)
+        string(FIND "abcdefghijklmnopqrstuvwxyz" "${letter}" offset)
+        if(decade STREQUAL "0" AND letter STREQUAL "x")
+            set(year 2011)
+        elseif(decade STREQUAL "1" AND offset GREATER_EQUAL 24)
+            math(EXPR year "2014 + 3 * (${offset} - 24)")
+        elseif(decade STREQUAL "2")
+            math(EXPR year "2020 + 3 * ${offset}")
+        endif()
+    elseif(text MATCHES "^[^0-9]*([0-9][0-9]?[0-9]?[0-9]?)")
+        set(digits "${CMAKE_MATCH_1}")
+        string(LENGTH "${digits}" digit_count)
+        # Strip leading zeros so math() does not read octal-looking input.
+        string(REGEX REPLACE "^0+([0-9])" "\\1" number "${digits}")
+        if(digit_count LESS_EQUAL 2)
+            if(number GREATER_EQUAL 70)
+                math(EXPR year "1900 + ${number}")
+            else()
+                math(EXPR year "2000 + ${number}")
+            endif()
+        else()
+            set(year "${number}")
+        endif()
+    endif()
+    set(${out} "${year}" PARENT_SCOPE)
+endfunction()
+
+# Version sections of cpp_modern_features (members holding a "features"
+# array), ordered like TechniqueParser::sectionBefore: by the standard year in
+# the key, keys without digits last, then by key.
+function(_cmt_section_keys out root)
+    set(sortable "")
+    string(JSON member_count LENGTH "${root}")
+    if(member_count GREATER 0)
+        math(EXPR last_member "${member_count} - 1")
+        foreach(m RANGE ${last_member})
+            string(JSON key MEMBER "${root}" ${m})
+            string(JSON type ERROR_VARIABLE err TYPE "${root}" "${key}" features)
+            if(err OR NOT type STREQUAL "ARRAY")
+                continue()
+            endif()
+            _cmt_standard_year(year "${key}")
+            if(year EQUAL 0)
+                set(year 10000)
+            endif()
+            list(APPEND sortable "${year}|${key}")
+        endforeach()
+    endif()
+    # Zero-pad the years so a plain string sort orders them numerically.
+    set(padded "")
+    foreach(entry IN LISTS sortable)
+        string(REGEX MATCH "^[0-9]+" year "${entry}")
+        string(LENGTH "${year}" year_length)
+        math(EXPR pad "5 - ${year_length}")
+        string(REPEAT "0" ${pad} padding)
+        list(APPEND padded "${padding}${entry}")
+    endforeach()
+    list(SORT padded)
+    set(keys "")
+    foreach(entry IN LISTS padded)
+        string(REGEX REPLACE "^[0-9]+\\|" "" key "${entry}")
+        list(APPEND keys "${key}")
+    endforeach()
+    set(${out} "${keys}" PARENT_SCOPE)
+endfunction()
+
+function(cmt_embed_catalog json_file header_file)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${json_file}")
+    file(READ "${json_file}" catalog)
+    string(JSON root ERROR_VARIABLE err GET "${catalog}" cpp_modern_features)
+    if(err)
+        message(FATAL_ERROR "${json_file}: missing cpp_modern_features (${err})")
+    endif()
+
+    set(decls "")
+    set(entries "")
+    set(index 0)
+    _cmt_section_keys(section_keys "${root}")
+    foreach(section_key IN LISTS section_keys)
+        string(JSON section GET "${root}" ${section_key})
+        _cmt_json_string(cpp_version "${section}" version)
+        string(JSON features GET "${section}" features)
+        string(JSON count LENGTH "${features}")
+        if(count EQUAL 0)
+            continue()
+        endif()
+        math(EXPR last "${count} - 1")
+        foreach(i RANGE ${last})
+            string(JSON item GET "${features}" ${i})
+            _cmt_json_string(name "${item}" name)
+            _cmt_json_string(definition "${item}" definition)
+            _cmt_json_string(demo_code "${item}" complete_demo code)
+            _cmt_json_string(expected_output "${item}" complete_demo expected_output)
+
+            # syntax: either a string, or "key: value\n" per member in key order
+            # (nlohmann::json objects iterate sorted by key).
+            set(syntax "")
+            string(JSON syntax_type ERROR_VARIABLE err TYPE "${item}" syntax)
+            if(NOT err AND syntax_type STREQUAL "STRING")
+                string(JSON syntax GET "${item}" syntax)
+            elseif(NOT err AND syntax_type STREQUAL "OBJECT")
+                string(JSON member_count LENGTH "${item}" syntax)
+                set(keys "")
+                if(member_count GREATER 0)
+                    math(EXPR last_member "${member_count} - 1")
+                    foreach(m RANGE ${last_member})
+                        string(JSON key MEMBER "${item}" syntax ${m})
+                        list(APPEND keys "${key}")
+                    endforeach()
+                endif()
+                list(SORT keys)
+                foreach(key IN LISTS keys)
+                    string(JSON value GET "${item}" syntax "${key}")
+                    string(APPEND syntax "${key}: ${value}\n")
+                endforeach()
+            endif()
+
+            set(notes "")
+            _cmt_json_string(category "${item}" category)
+            _cmt_json_string(level "${item}" complexity_level)
+            _cmt_json_string(improvements "${item}" key_improvements)
+            string(JSON has ERROR_VARIABLE err TYPE "${item}" category)
+            if(NOT err)
+                string(APPEND notes "Category: ${category}\n")
+            endif()
+            string(JSON has ERROR_VARIABLE err TYPE "${item}" complexity_level)
+            if(NOT err)
+                string(APPEND notes "Level: ${level}\n")
+            endif()
+            string(JSON has ERROR_VARIABLE err TYPE "${item}" key_improvements)
+            if(NOT err)
+                string(APPEND notes "Improvements: ${improvements}\n")
+            endif()
+
+            _cmt_json_list(use_decl use_span usage "${item}" feature${index}_use_cases primary_use_cases)
+            _cmt_json_list(bp_decl bp_span unused "${item}" feature${index}_best_practices best_practices)
+            _cmt_json_list(adv_decl adv_span unused "${item}" feature${index}_advantages advantages)
+            string(APPEND decls "${use_decl}${bp_decl}${adv_decl}")
+
+            set(fields "")
+            foreach(field name definition usage syntax demo_code cpp_version notes expected_output)
+                _cmt_raw_literal(literal "${${field}}")
+                string(APPEND fields "        ${literal},\n")
+            endforeach()
+            string(APPEND entries "    EmbeddedFeature{\n${fields}        ${use_span},\n        ${bp_span},\n        ${adv_span}\n    },\n")
+            math(EXPR index "${index} + 1")
+        endforeach()
+    endforeach()
+
+    if(index EQUAL 0)
+        set(table "inline constexpr std::span<const EmbeddedFeature> features{};\n")
+    else()
+        set(table "inline constexpr EmbeddedFeature featureTable[] = {\n${entries}};\n\ninline constexpr std::span<const EmbeddedFeature> features(featureTable);\n")
+    endif()
+
+    set(content "// Generated from techniques.json by cmake/EmbedCatalog.cmake. Do not edit.\n")
+    string(APPEND content "#ifndef EMBEDDEDCATALOGDATA_H\n#define EMBEDDEDCATALOGDATA_H\n")
+    string(APPEND content "#include <span>\n#include <string_view>\n#include \"EmbeddedCatalog.h\"\n\n")
+    string(APPEND content "namespace embedded_catalog {\n\n${decls}\n${table}\n} // namespace embedded_catalog\n\n")
+    string(APPEND content "#endif // EMBEDDEDCATALOGDATA_H\n")
+    # Only touch the header when it changes, to avoid needless rebuilds.
+    file(WRITE "${header_file}.tmp" "${content}")
+    configure_file("${header_file}.tmp" "${header_file}" COPYONLY)
+    file(REMOVE "${header_file}.tmp")
+endfunction()
@@ -0,0 +1,355 @@
+#include "technique/Header/TechniqueManager.h"
+#include "technique/Header/DemoRunner.h"
+#include "technique/Header/DetailPage.h"
+#include "technique/Header/SnapshotCatalog.h"
+#include "TerminalFrame.h"
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// Benchmarks for the catalog loaders, joinVector, tracing overhead, detail
+// page rendering and the demo compile-and-run pipeline. Every benchmark reports wall-time
+// percentiles and heap allocations per iteration; results go to a JSON file
+// so runs can be diffed against each other.
+
+namespace {
+    std::atomic<size_t> allocationCount{0};
+    std::atomic<size_t> allocatedBytes{0};
+
+    void* countedAlloc(size_t size, size_t alignment) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        void* p = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+            ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+            : std::malloc(size);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+}
+
+void* operator new(size_t size) { return countedAlloc(size, 0); }
+void* operator new[](size_t size) { return countedAlloc(size, 0); }
+void* operator new(size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<size_t>(align)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+    namespace fs = std::filesystem;
+    using json = nlohmann::json;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        size_t maxFeatures = 100000;
+        size_t minIterations = 5;
+        size_t maxIterations = 200;
+        double budgetSeconds = 2.0;
+        bool demos = true;
+        std::string filter;
+        std::string output = "bench_results.json";
+    };
+
+    struct Stats {
+        std::string name;
+        json params;
+        std::vector<double> samples;  // nanoseconds per iteration
+        size_t allocations = 0;
+        size_t bytes = 0;
+    };
+
+    double percentile(const std::vector<double>& sorted, double p) {
+        // Nearest-rank percentile.
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    class Suite {
+    private:
+        Options options;
+        std::vector<Stats> results;
+    public:
+        explicit Suite(Options options) : options(std::move(options)) {}
+
+        // Times body after one untimed warm-up run, for at least minIterations
+        // and then until the time budget or the iteration cap is reached.
+        void run(const std::string& name, json params, const std::function<void()>& body,
+                 size_t maxIterations = 0) {
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+            size_t limit = maxIterations ? std::min(maxIterations, options.maxIterations) : options.maxIterations;
+            Stats stats{name, std::move(params), {}, 0, 0};
+            body();
+            auto suiteStart = Clock::now();
+            while (stats.samples.size() < limit) {
+                if (stats.samples.size() >= options.minIterations &&
+                    std::chrono::duration<double>(Clock::now() - suiteStart).count() > options.budgetSeconds) {
+                    break;
+                }
+                size_t allocBefore = allocationCount.load(std::memory_order_relaxed);
+                size_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+                auto start = Clock::now();
+                body();
+                auto end = Clock::now();
+                stats.allocations += allocationCount.load(std::memory_order_relaxed) - allocBefore;
+                stats.bytes += allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+                stats.samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+            print(stats);
+            results.push_back(std::move(stats));
+        }
+
+        void print(const Stats& stats) const {
+            std::vector<double> sorted = stats.samples;
+            std::sort(sorted.begin(), sorted.end());
+            size_t n = sorted.size();
+            std::cout << std::left << std::setw(28) << stats.name << std::setw(22) << stats.params.dump()
+                      << std::right << std::fixed << std::setprecision(3)
+                      << " p50 " << std::setw(12) << percentile(sorted, 50) / 1e6 << " ms"
+                      << "  p90 " << std::setw(12) << percentile(sorted, 90) / 1e6 << " ms"
+                      << "  allocs/iter " << std::setw(10) << stats.allocations / n
+                      << "  (n=" << n << ")\n";
+        }
+
+        json toJson() const {
+            json benchmarks = json::array();
+            for (const auto& stats : results) {
+                std::vector<double> sorted = stats.samples;
+                std::sort(sorted.begin(), sorted.end());
+                size_t n = sorted.size();
+                double sum = 0;
+                for (double s : sorted) sum += s;
+                benchmarks.push_back({
+                    {"name", stats.name},
+                    {"params", stats.params},
+                    {"iterations", n},
+                    {"ns", {{"min", sorted.front()}, {"p50", percentile(sorted, 50)},
+                            {"p90", percentile(sorted, 90)}, {"p99", percentile(sorted, 99)},
+                            {"max", sorted.back()}, {"mean", sum / n}}},
+                    {"allocations_per_iter", static_cast<double>(stats.allocations) / n},
+                    {"bytes_per_iter", static_cast<double>(stats.bytes) / n},
+                });
+            }
+            return {{"benchmarks", benchmarks}};
+        }
+    };
+
+    // Catalog shaped like techniques.json with count features spread over the
+    // three sections. Content is deterministic so runs are comparable.
+    void writeSyntheticCatalog(const fs::path& path, size_t count) {
+        static const char* const SECTIONS[][2] = {
+            {"cpp17_features", "C++17"}, {"cpp20_features", "C++20"}, {"cpp23_features", "C++23"}};
+        std::ofstream out(path);
+        out << "{\"cpp_modern_features\":{\"metadata\":{\"total_features\":" << count << "}";
+        for (size_t s = 0; s < 3; ++s) {
+            out << ",\"" << SECTIONS[s][0] << "\":{\"version\":\"" << SECTIONS[s][1] << "\",\"features\":[";
+            bool first = true;
+            for (size_t i = s; i < count; i += 3) {
+                if (!first) out << ",";
+                first = false;
+                out << "{\"id\":\"feature_" << i << "\",\"name\":\"Feature " << i << "\","
+                    << "\"category\":\"Language Core\",\"complexity_level\":\"Intermediate\","
+                    << "\"definition\":\"Synthetic feature " << i << " used to measure loading of large catalogs.\","
+                    << "\"primary_use_cases\":[\"Benchmarking loaders\",\"Stress testing the menu\",\"Case " << i << "\"],"
+                    << "\"syntax\":{\"basic\":\"auto x" << i << " = make_feature<" << i << ">();\",\"const\":\"const auto y = f();\"},"
+                    << "\"complete_demo\":{\"code\":\"#include <iostream>\\nint main() {\\n    std::cout << " << i
+                    << " << std::endl;\\n    return 0;\\n}\\n\",\"expected_output\":\"" << i << "\"},"
+                    << "\"best_practices\":[\"Keep it simple\",\"Measure before optimizing\"],"
+                    << "\"advantages\":[\"Deterministic\",\"Cheap to generate\"],"
+                    << "\"compiler_support\":{\"gcc\":\"7+\",\"clang\":\"5+\"}}";
+            }
+            out << "]}";
+        }
+        out << "}}\n";
+    }
+
+    void benchLoaders(Suite& suite, const Options& options, const fs::path& workDir) {
+        for (size_t count = 10; count <= options.maxFeatures; count *= 10) {
+            fs::path jsonPath = workDir / ("catalog_" + std::to_string(count) + ".json");
+            writeSyntheticCatalog(jsonPath, count);
+            std::string path = jsonPath.string();
+            std::string snapshot = TechniqueManager::snapshotPathFor(path);
+            {
+                TechniqueManager source;
+                source.loadFromJson(path);
+                SnapshotCatalog::write(*source.getCatalog(), snapshot, path);
+            }
+            json params = {{"features", count}};
+            suite.run("load/json_eager", params, [&] {
+                TechniqueManager manager;
+                if (!manager.loadFromJson(path)) std::abort();
+            });
+            suite.run("load/json_lazy", params, [&] {
+                TechniqueManager manager;
+                if (!manager.loadFromJsonLazy(path)) std::abort();
+            });
+            suite.run("load/json_arena", params, [&] {
+                TechniqueManager manager;
+                if (!manager.loadFromJsonArena(path)) std::abort();
+            });
+            suite.run("load/snapshot", params, [&] {
+                TechniqueManager manager;
+                if (!manager.loadFromSnapshot(snapshot, path)) std::abort();
+            });
+        }
+    }
+
+    void benchJoinVector(Suite& suite) {
+        for (size_t count : {4, 64, 1024}) {
+            std::vector<std::string> items;
+            for (size_t i = 0; i < count; ++i) items.push_back("Use case number " + std::to_string(i));
+            suite.run("joinVector", {{"items", count}}, [&] {
+                std::string joined = TechniqueManager::joinVector(items, "\n- ");
+                if (joined.empty()) std::abort();
+            });
+        }
+    }
+
+    // Cost of instrumentation: 1000 spans per iteration, tracing off and on.
+    void benchTrace(Suite& suite) {
+        auto spans = [] {
+            for (int i = 0; i < 1000; ++i) TraceSpan span("bench.span");
+        };
+        suite.run("trace/span_disabled", {{"spans", 1000}}, spans);
+        Trace::enable();
+        suite.run("trace/span_enabled", {{"spans", 1000}}, spans);
+        Trace::disable();
+    }
+
+    // Same frame Menu::showTechniqueDetail sends, written to /dev/null.
+    void benchRender(Suite& suite, const TechniqueManager& manager) {
+        int nullFd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+        if (nullFd < 0) return;
+        const Technique& tech = manager.getTechnique(0);
+        TerminalFrame frame(nullFd);
+        DetailPageCache pages;
+        auto draw = [&](const std::vector<std::string>& page) {
+            frame.begin();
+            for (const auto& line : page) frame << line << TerminalFrame::EOL;
+            frame << "Select: ";
+            if (!frame.present()) std::abort();
+        };
+        suite.run("render/detail_cold", {{"technique", tech.getName()}}, [&] {
+            draw(DetailPage::render(tech));
+        });
+        suite.run("render/detail_cached", {{"technique", tech.getName()}}, [&] {
+            draw(pages.get(tech));
+        });
+        ::close(nullFd);
+    }
+
+    void benchDemo(Suite& suite, const TechniqueManager& manager, const fs::path& workDir) {
+        const std::string& code = manager.getTechnique(0).getDemoCode();
+        json params = {{"technique", manager.getTechnique(0).getName()}};
+        auto check = [](const DemoResult& result) {
+            if (!result.compiled || result.exitCode != 0) std::abort();
+        };
+        // Every compile takes on the order of a second; keep these short.
+        constexpr size_t DEMO_ITERATIONS = 5;
+        suite.run("demo/compile_run", params, [&] {
+            check(DemoRunner().compileAndRun(code));
+        }, DEMO_ITERATIONS);
+
+        DemoCache cache(workDir / "demo_cache");
+        DemoPrelude prelude(workDir / "pch");
+        suite.run("demo/compile_run_pch", params, [&] {
+            check(DemoRunner(nullptr, &prelude).compileAndRun(code));
+        }, DEMO_ITERATIONS);
+        suite.run("demo/cache_hit_run", params, [&] {
+            check(DemoRunner(&cache).compileAndRun(code));
+        });
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--max-features" && hasValue) options.maxFeatures = std::stoul(argv[++i]);
+            else if (arg == "--min-iterations" && hasValue) options.minIterations = std::stoul(argv[++i]);
+            else if (arg == "--max-iterations" && hasValue) options.maxIterations = std::stoul(argv[++i]);
+            else if (arg == "--budget" && hasValue) options.budgetSeconds = std::stod(argv[++i]);
+            else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+            else if (arg == "--output" && hasValue) options.output = argv[++i];
+            else if (arg == "--no-demo") options.demos = false;
+            else return false;
+        }
+        options.minIterations = std::max<size_t>(options.minIterations, 1);
+        options.maxIterations = std::max(options.maxIterations, options.minIterations);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--max-features N] [--min-iterations N] [--max-iterations N] [--budget SECONDS]"
+                  << " [--filter SUBSTRING] [--output FILE] [--no-demo]\n";
+        return 2;
+    }
+
+    std::string tmpl = (fs::temp_directory_path() / "cmt-bench-XXXXXX").string();
+    if (!mkdtemp(tmpl.data())) {
+        std::cerr << "Cannot create a temporary directory\n";
+        return 1;
+    }
+    fs::path workDir = tmpl;
+
+    Suite suite(options);
+    benchLoaders(suite, options, workDir);
+    benchJoinVector(suite);
+    benchTrace(suite);
+
+    // Render and demo benchmarks use the real catalog when it can be found.
+    TechniqueManager manager;
+    const char* const possiblePaths[] = {
+        "techniques.json",
+        "src/technique/techniques.json",
+        "../src/technique/techniques.json"
+    };
+    bool loaded = false;
+    for (const char* path : possiblePaths) {
+        if (manager.loadFromJson(path)) {
+            loaded = true;
+            break;
+        }
+    }
+    if (!loaded) {
+        fs::path fallback = workDir / "catalog_render.json";
+        writeSyntheticCatalog(fallback, 3);
+        manager.loadFromJson(fallback.string());
+    }
+    benchRender(suite, manager);
+    if (options.demos) benchDemo(suite, manager, workDir);
+
+    std::error_code ec;
+    fs::remove_all(workDir, ec);
+
+    std::ofstream out(options.output);
+    out << suite.toJson().dump(2) << "\n";
+    if (!out) {
+        std::cerr << "Cannot write " << options.output << "\n";
+        return 1;
+    }
+    std::cout << "Results written to " << options.output << "\n";
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include "technique/Header/TechniqueManager.h"
+#include "technique/Header/SnapshotCatalog.h"
+#include <iostream>
+#include <string>
+
+// Converts techniques.json into the binary snapshot loaded by
+// TechniqueManager::loadFromSnapshot.
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <techniques.json> <techniques.cat>\n";
+        return 2;
+    }
+    std::string input = argv[1];
+    std::string output = argv[2];
+
+    TechniqueManager manager;
+    if (!manager.loadFromJson(input)) {
+        std::cerr << "Cannot load " << input << "\n";
+        return 1;
+    }
+    if (!SnapshotCatalog::write(*manager.getCatalog(), output, input)) {
+        std::cerr << "Cannot write " << output << "\n";
+        return 1;
+    }
+
+    SnapshotCatalog check;
+    if (!check.open(output, input) || !check.verifyBlob() || check.size() != manager.size()) {
+        std::cerr << "Snapshot " << output << " failed verification\n";
+        return 1;
+    }
+    std::cout << "Wrote " << check.size() << " techniques to " << output << "\n";
+    return 0;
+}
@@ -1,24 +1,143 @@
 #include "technique/Header/TechniqueManager.h"
 #include "technique/Header/Menu.h"
+#include "technique/Header/DemoMatrix.h"
+#include "technique/Header/DemoVerifier.h"
+#include "technique/Header/ArenaCatalog.h"
+#include "technique/Header/CatalogServer.h"
+#include "technique/Header/CatalogWatcher.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <string>
+#include <vector>
 
-int main() {
+int main(int argc, char* argv[]) {
+    bool verifyAll = false;
+    bool matrix = false;
+    std::vector<std::string> optLevels = {"-O0", "-O2"};
+    bool usePch = true;
+    bool useArena = false;
+    bool memoryReport = false;
+    bool searchMode = false;
+    bool watch = true;
+    std::string catalogPath;
+    std::string searchQuery;
+    std::string serveAddress;
+    std::string tracePath;
+    bool printStats = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verify-all") {
+            verifyAll = true;
+        } else if (arg == "--matrix") {
+            matrix = true;
+        } else if (arg == "--opt-levels" && i + 1 < argc) {
+            // Comma-separated, e.g. -O0,-O2,-O3
+            optLevels.clear();
+            std::string list = argv[++i];
+            for (size_t start = 0; start <= list.size();) {
+                size_t end = std::min(list.find(',', start), list.size());
+                if (end > start) optLevels.push_back(list.substr(start, end - start));
+                start = end + 1;
+            }
+        } else if (arg == "--arena") {
+            useArena = true;
+        } else if (arg == "--memory-report") {
+            memoryReport = true;
+        } else if (arg == "--search" && i + 1 < argc) {
+            searchMode = true;
+            searchQuery = argv[++i];
+        } else if (arg == "--serve" && i + 1 < argc) {
+            serveAddress = argv[++i];
+        } else if (arg == "--catalog" && i + 1 < argc) {
+            catalogPath = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--stats") {
+            printStats = true;
+        } else if (arg == "--no-watch") {
+            watch = false;
+        } else if (arg == "--no-pch") {
+            usePch = false;
+        } else if (arg == "--build-pch") {
+            DemoPrelude prelude;
+            std::string errors;
+            bool ok = prelude.buildAll(errors);
+            std::cerr << errors;
+            return ok ? 0 : 1;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n"
+                      << "Usage: " << argv[0]
+                      << " [--verify-all] [--matrix [--opt-levels -O0,-O2]] [--no-pch] [--build-pch] [--arena] [--memory-report]"
+                      << " [--search <query>] [--serve <port|socket path>] [--no-watch] [--trace <file.json>] [--stats]"
+                      << " [--catalog <file|directory|glob>]\n";
+            return 2;
+        }
+    }
+
+    // Declared before everything it observes so it is written out last.
+    TraceSession traceSession(tracePath, printStats);
     TechniqueManager manager;
-    // Try multiple possible paths
-    std::vector<std::string> possiblePaths = {
-        "src/technique/techniques.json",
-        "../src/technique/techniques.json",
-        "./src/technique/techniques.json",
-        "techniques.json"
+    // Startup always takes the snapshot/lazy path; the watcher builds the
+    // LiveCatalog it diffs edits against on its own thread. A reload would
+    // swap the arena layout out, so --arena turns hot reload off.
+    bool interactive = !verifyAll && !matrix && !searchMode && !memoryReport;
+    bool liveReload = watch && interactive && !useArena;
+    if (watch && interactive && useArena) std::cerr << "Hot reload is disabled with --arena\n";
+    auto loadJson = [&](const std::string& path) {
+        if (useArena) return manager.loadFromJsonArena(path);
+        return manager.loadCatalog(path);
     };
-
-    bool loaded = false;
-    for (const auto& path : possiblePaths) {
-        if (manager.loadFromJson(path)) {
+    // Kiosk builds carry the catalog in the binary and never touch the disk.
+    bool loaded = manager.loadEmbedded();
+    std::string loadedPath;  // the single JSON file behind the catalog, if any
+    std::string watchPath;   // what the watcher reloads: that file or the shard set
+    if (!loaded && !catalogPath.empty()) {
+        if (ShardLoader::isShardSet(catalogPath)) {
+            ShardLoadReport report;
+            loaded = manager.loadFromShards(catalogPath, report);
+            if (loaded) watchPath = catalogPath;
+            std::cerr << report.errors;
+            if (loaded && report.duplicates > 0) {
+                std::cerr << report.duplicates << " duplicate feature id(s) resolved by shard priority\n";
+            }
+        } else if (loadJson(catalogPath)) {
             loaded = true;
-            break;
+            loadedPath = catalogPath;
+        }
+    } else if (!loaded) {
+        // Try multiple possible paths
+        const char* const possiblePaths[] = {
+            "src/technique/techniques.json",
+            "../src/technique/techniques.json",
+            "./src/technique/techniques.json",
+            "techniques.json"
+        };
+        TraceSpan probing("main.probePaths");
+        // An up-to-date snapshot at any candidate beats parsing JSON: the
+        // build writes techniques.cat next to its own copy of the JSON, which
+        // is the last candidate when running from build/.
+        if (!useArena && !memoryReport) {
+            for (const char* path : possiblePaths) {
+                TraceSpan probe("main.probeSnapshot");
+                if (manager.loadFromSnapshot(TechniqueManager::snapshotPathFor(path), path)) {
+                    loaded = true;
+                    loadedPath = path;
+                    break;
+                }
+            }
+        }
+        for (const char* path : possiblePaths) {
+            if (loaded) break;
+            TraceSpan probe("main.probePath");
+            if (loadJson(path)) {
+                loaded = true;
+                loadedPath = path;
+                break;
+            }
         }
     }
 
@@ -26,8 +145,68 @@ int main() {
         std::cerr << "Không thể load file JSON kỹ thuật!\n";
         return 1;
     }
+    if (watchPath.empty()) watchPath = loadedPath;
+    // Pick up edits to the catalog while the menu or the server is running.
+    auto startWatcher = [&](CatalogWatcher& watcher) {
+        // Embedded catalogs have nothing to watch.
+        if (liveReload && !watchPath.empty() && !watcher.start()) {
+            std::cerr << "Hot reload is disabled: cannot watch " << watchPath << "\n";
+        }
+    };
+
+    if (memoryReport) {
+        if (!loadedPath.empty()) return ArenaCatalog::writeMemoryReport(loadedPath, std::cout) ? 0 : 1;
+        // Shards and embedded tables have no single JSON file to load in both layouts.
+        CatalogMemoryUsage usage = manager.getCatalog()->memoryUsage();
+        std::cout << "Catalog memory (" << manager.size() << " techniques): " << usage.bytes << " heap bytes in "
+                  << usage.allocations << " allocations\n";
+        return 0;
+    }
+
+    if (searchMode) {
+        auto snapshot = manager.getCatalog();
+        auto hits = manager.search(snapshot, searchQuery);
+        for (const auto& hit : hits) {
+            std::cout << hit.score << "\t" << snapshot->name(hit.index) << " (" << snapshot->cppVersion(hit.index) << ")\n";
+        }
+        return hits.empty() ? 1 : 0;
+    }
+
+    if (matrix) {
+        auto start = std::chrono::steady_clock::now();
+        DemoMatrix runner(manager, DemoMatrix::availableCompilers(), optLevels);
+        auto rows = runner.run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return DemoMatrix::report(rows, seconds, std::cout);
+    }
+
+    if (verifyAll) {
+        auto start = std::chrono::steady_clock::now();
+        DemoCache cache;
+        DemoVerifier verifier(manager, &cache);
+        auto results = verifier.run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        int status = DemoVerifier::report(results, seconds, std::cout);
+        std::cout << "Demo cache: " << cache.hits() << " hits, " << cache.misses() << " misses ("
+                  << cache.getDirectory().string() << ")\n";
+        return status;
+    }
+
+    if (!serveAddress.empty()) {
+        // Created first: it blocks SIGINT/SIGTERM for every thread started after it.
+        CatalogServer server(manager, serveAddress, usePch);
+        CatalogWatcher watcher(manager, watchPath);
+        startWatcher(watcher);
+        std::cerr << "Serving " << manager.size() << " techniques on " << serveAddress << "\n";
+        std::string errors;
+        bool ok = server.run(errors);
+        std::cerr << errors;
+        return ok ? 0 : 1;
+    }
 
-    Menu menu(manager);
+    CatalogWatcher watcher(manager, watchPath);
+    startWatcher(watcher);
+    Menu menu(manager, usePch, &watcher);
     menu.show();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,100 @@
+#ifndef ARENACATALOG_H
+#define ARENACATALOG_H
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ICatalog.h"
+
+// Compact storage engine: all text is copied into monotonic arenas, values
+// that repeat across records (versions, categories, complexity levels,
+// section improvements) are interned once, and fields are kept in parallel
+// structure-of-arrays columns. Names live in their own arena so listing the
+// catalog walks a small, dense region. Technique objects are only built on
+// demand for the detail page.
+class ArenaCatalog : public ICatalog {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    bool load(const std::string& filename);
+
+    size_t size() const override;
+    std::string_view name(size_t index) const override;
+    std::string_view cppVersion(size_t index) const override;
+    const Technique& technique(size_t index) const override;
+    void visitText(size_t index, const TextVisitor& visit) const override;
+    CatalogMemoryUsage memoryUsage() const override;
+
+    std::string_view category(size_t index) const;
+    std::string_view level(size_t index) const;
+    std::string_view definition(size_t index) const;
+    std::string_view syntax(size_t index) const;
+    std::string_view demoCode(size_t index) const;
+    std::string_view expectedOutput(size_t index) const;
+    std::span<const std::string_view> useCases(size_t index) const;
+    std::span<const std::string_view> bestPractices(size_t index) const;
+    std::span<const std::string_view> advantages(size_t index) const;
+    size_t internedCount() const;
+
+    // Loads filename with both the VectorCatalog and this layout and prints
+    // their heap footprints side by side.
+    static bool writeMemoryReport(const std::string& filename, std::ostream& out);
+
+private:
+    // Counts what the arenas request from the heap.
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t bytes = 0;
+        size_t allocations = 0;
+    private:
+        void* do_allocate(size_t size, size_t alignment) override;
+        void do_deallocate(void* p, size_t size, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    struct ListRange {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    CountingResource upstream;
+    // Created by load() with their exact sizes, so each is one allocation.
+    std::optional<std::pmr::monotonic_buffer_resource> hotArena;
+    std::optional<std::pmr::monotonic_buffer_resource> coldArena;
+
+    std::vector<std::string_view> interned;
+    std::unordered_map<std::string_view, uint32_t> internIds;
+
+    // Hot columns, touched when listing.
+    std::vector<std::string_view> names;
+    std::vector<uint32_t> versions;
+    // Cold columns, touched when a feature is opened.
+    std::vector<uint32_t> categories;
+    std::vector<uint32_t> levels;
+    std::vector<uint32_t> improvements;
+    std::vector<std::string_view> definitions;
+    std::vector<std::string_view> syntaxes;
+    std::vector<std::string_view> demoCodes;
+    std::vector<std::string_view> expectedOutputs;
+    std::vector<std::string_view> listItems;
+    std::vector<ListRange> useCaseRanges;
+    std::vector<ListRange> bestPracticeRanges;
+    std::vector<ListRange> advantageRanges;
+
+    mutable std::mutex materializeMutex;
+    mutable std::vector<std::unique_ptr<Technique>> materialized;
+
+    std::string_view store(std::pmr::memory_resource& arena, std::string_view text);
+    uint32_t intern(std::string_view text);
+    std::string_view internedText(uint32_t id) const;
+    std::span<const std::string_view> list(const std::vector<ListRange>& ranges, size_t index) const;
+};
+
+#endif // ARENACATALOG_H
@@ -0,0 +1,126 @@
+#ifndef CATALOGSERVER_H
+#define CATALOGSERVER_H
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DemoCache.h"
+#include "DemoPrelude.h"
+#include "ThreadPool.h"
+#include "TechniqueManager.h"
+
+// Serves the loaded catalog to many clients from one process, over a Unix
+// domain socket or a localhost TCP port. The protocol is line based: each
+// request is one line and each response is one JSON object on one line.
+//
+//   LIST                 -> {"ok":true,"techniques":[{"index":0,"name":...,"version":...}, ...]}
+//   DETAIL <index>       -> {"ok":true,"index":0,"name":...,"definition":..., ...}
+//   SEARCH <query>       -> {"ok":true,"hits":[{"index":3,"name":...,"score":...}, ...]}
+//   RUN <index>          -> {"ok":true,"index":0,"compiled":true,"output":..., ...}
+//   QUIT                 -> closes the connection
+//
+// All sockets are driven by one epoll loop on the calling thread. LIST and
+// DETAIL responses are serialized once per catalog snapshot and shared by
+// every connection; they are handed to writev() straight from the cache.
+// RUN and SEARCH are executed on a bounded worker pool and their completion
+// is signalled back to the loop through an eventfd, so compiles and index
+// builds never block other clients.
+// Responses on one connection always come back in request order. A client
+// that stops reading is not read from either once MAX_QUEUED_REPLIES replies
+// are waiting for it. On shutdown, requests still queued for the workers are
+// answered with an error rather than run.
+class CatalogServer {
+private:
+    using Buffer = std::shared_ptr<const std::string>;
+
+    struct Slot {
+        uint64_t sequence;
+        Buffer data;  // null until its worker job completes
+    };
+
+    struct Connection {
+        int fd = -1;
+        std::string input;
+        std::deque<Slot> output;
+        size_t sentOfFront = 0;
+        uint64_t nextSequence = 0;
+        bool closing = false;
+        uint32_t interest = 0;  // epoll events currently registered
+    };
+
+    struct Completion {
+        uint64_t connection;
+        uint64_t sequence;
+        Buffer data;
+    };
+
+    TechniqueManager& manager;
+    std::string address;
+    bool usePch;
+    size_t workerCount;
+    size_t maxPendingJobs;
+
+    int epollFd = -1;
+    int listenFd = -1;
+    int wakeFd = -1;
+    int signalFd = -1;
+    std::string socketPath;  // removed on shutdown when listening on a Unix socket
+    sigset_t previousMask;
+
+    std::shared_ptr<const ICatalog> catalog;
+    Buffer listResponse;
+    std::vector<Buffer> detailResponses;
+
+    uint64_t nextConnectionId = 16;
+    std::unordered_map<uint64_t, Connection> connections;
+    size_t pendingJobs = 0;  // RUN and SEARCH requests handed to the workers
+
+    DemoCache demoCache;
+    DemoPrelude demoPrelude;
+    std::unique_ptr<ThreadPool> workers;
+    std::atomic<bool> cancelled{false};  // set on shutdown; queued jobs reply with an error
+    std::mutex completionMutex;
+    std::vector<Completion> completions;
+
+    bool listen();
+    void refreshCatalog();
+    void accept();
+    void readFrom(uint64_t id, Connection& connection);
+    void handleInput(uint64_t id, Connection& connection);
+    void handleLine(uint64_t id, Connection& connection, const std::string& line);
+    // Runs job on the worker pool; its reply fills a slot reserved now.
+    void submit(uint64_t id, Connection& connection, const std::string& command, std::function<Buffer()> job);
+    Buffer runBody(const ICatalog& snapshot, size_t index);
+    void drainCompletions();
+    void flush(uint64_t id, Connection& connection);
+    void updateInterest(uint64_t id, Connection& connection);
+    void close(uint64_t id);
+    void shutdown();
+
+    Buffer listBody();
+    Buffer detailBody(size_t index);
+    static Buffer error(const std::string& message);
+    static bool backlogged(const Connection& connection);
+public:
+    static constexpr size_t MAX_LINE = 4096;
+    static constexpr size_t MAX_QUEUED_REPLIES = 64;  // per connection; reading pauses at this many
+
+    // address: a TCP port number (bound to 127.0.0.1) or a Unix socket path.
+    // Blocks SIGINT/SIGTERM on the calling thread so run() can take them
+    // through a signalfd; construct it before starting any other thread.
+    CatalogServer(TechniqueManager& manager, std::string address, bool usePch = true, size_t workers = 0);
+    ~CatalogServer();
+    CatalogServer(const CatalogServer&) = delete;
+    CatalogServer& operator=(const CatalogServer&) = delete;
+
+    // Runs until SIGINT or SIGTERM; false if the socket cannot be set up.
+    bool run(std::string& errors);
+};
+
+#endif // CATALOGSERVER_H
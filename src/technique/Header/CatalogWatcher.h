@@ -0,0 +1,55 @@
+#ifndef CATALOGWATCHER_H
+#define CATALOGWATCHER_H
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "TechniqueManager.h"
+
+// Watches the catalog file with inotify and reloads it into the manager on a
+// background thread whenever it is saved. The directory is watched rather
+// than the file so editors that save through a rename are picked up too.
+// A shard set (directory or glob, see ShardLoader) is reloaded as a whole
+// when any file matching it changes; a glob is watched through its parent
+// directory. start() returns false where inotify is unavailable or the
+// directory cannot be watched.
+//
+// The program starts from a snapshot or lazy catalog, which keeps no per-feature
+// hashes. The thread first loads the file into a LiveCatalog baseline so the
+// first edit is diffed too; it is dropped once a reload has published a
+// LiveCatalog of its own.
+class CatalogWatcher {
+private:
+    TechniqueManager& manager;
+    std::string path;
+    bool sharded;
+    std::string directory;   // what inotify watches
+    std::string namePattern; // fnmatch() pattern for the file names that matter
+    std::thread thread;
+    int inotifyFd = -1;
+    int stopFd = -1;
+    std::atomic<size_t> reloads{0};
+    std::atomic<size_t> failures{0};
+    std::unique_ptr<LiveCatalog> baseline;  // touched by the watcher thread only
+    mutable std::mutex errorMutex;
+    std::string errors;
+
+    void loop();
+    bool drainEvents();
+    bool reload();
+public:
+    CatalogWatcher(TechniqueManager& manager, std::string path);
+    ~CatalogWatcher();
+    CatalogWatcher(const CatalogWatcher&) = delete;
+    CatalogWatcher& operator=(const CatalogWatcher&) = delete;
+
+    bool start();
+    void stop();
+    size_t reloadCount() const;
+    size_t failureCount() const;
+    // What the latest reload could not load, one line per file; empty after a success.
+    std::string lastErrors() const;
+};
+
+#endif // CATALOGWATCHER_H
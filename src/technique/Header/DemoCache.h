@@ -0,0 +1,54 @@
+#ifndef DEMOCACHE_H
+#define DEMOCACHE_H
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// Persistent, content-addressed store of compiled demo binaries. The key covers
+// the demo source, the -std flag and the compiler's path and version, so a hit
+// is always a binary the current toolchain would have produced. Entries are
+// shared between sessions and evicted least-recently-used once the cache grows
+// past its size cap.
+class DemoCache {
+private:
+    std::filesystem::path directory;
+    uintmax_t maxBytes;
+    std::atomic<size_t> hitCount{0};
+    std::atomic<size_t> missCount{0};
+    std::atomic<size_t> evictionCount{0};
+    std::mutex evictMutex;
+    std::optional<uintmax_t> knownBytes;  // bytes of .out entries, once scanned
+
+    std::filesystem::path entryPath(const std::string& key) const;
+public:
+    static constexpr uintmax_t DEFAULT_MAX_BYTES = 256ULL * 1024 * 1024;
+    static constexpr const char* STAGING_MARKER = ".tmp.";
+    static constexpr std::chrono::minutes STALE_STAGING_AGE{10};
+
+    explicit DemoCache(std::filesystem::path directory = defaultDirectory(),
+                       uintmax_t maxBytes = defaultMaxBytes());
+
+    static std::filesystem::path defaultDirectory();
+    static uintmax_t defaultMaxBytes();
+    static std::string compilerIdentity(const std::string& compiler);
+
+    std::string key(const std::string& code, const std::string& stdFlag, const std::string& compiler) const;
+    // Links (or copies) the entry for key to destination; counts a hit only
+    // if the binary is actually there afterwards.
+    bool fetch(const std::string& key, const std::filesystem::path& destination);
+    bool store(const std::string& key, const std::filesystem::path& binary);
+    // Drops least-recently-used entries past the size cap and staging files
+    // older than STALE_STAGING_AGE.
+    void evict();
+
+    const std::filesystem::path& getDirectory() const;
+    size_t hits() const;
+    size_t misses() const;
+    size_t evictions() const;
+};
+
+#endif // DEMOCACHE_H
@@ -0,0 +1,48 @@
+#ifndef DEMOMATRIX_H
+#define DEMOMATRIX_H
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "TechniqueManager.h"
+
+struct MatrixCell {
+    std::string compiler;
+    std::string standard;     // e.g. "c++20"
+    std::string optFlag;
+    bool passed = false;      // compiled, ran cleanly and printed the expected output
+    std::string failure;
+    double compileSeconds = 0.0;
+    long compilerMaxRssKb = 0;
+    uintmax_t binaryBytes = 0;
+};
+
+struct MatrixRow {
+    std::string name;
+    std::vector<MatrixCell> cells;  // compiler-major, then standard, then opt level
+};
+
+// Builds every demo under each compiler x -std x optimization level, without
+// the demo cache or prelude so compile times and memory are real, spreading
+// the cells over a thread pool. Used to pick toolchains and to find the
+// oldest standard each feature actually needs.
+class DemoMatrix {
+private:
+    const TechniqueManager& manager;
+    std::vector<std::string> compilers;
+    std::vector<std::string> optFlags;
+    size_t threads;
+public:
+    static constexpr const char* STANDARDS[] = {"c++17", "c++20", "c++23"};
+
+    DemoMatrix(const TechniqueManager& manager, std::vector<std::string> compilers = availableCompilers(),
+               std::vector<std::string> optFlags = {"-O0", "-O2"}, size_t threads = 0);
+    // g++ and clang++, whichever are on PATH.
+    static std::vector<std::string> availableCompilers();
+    std::vector<MatrixRow> run() const;
+    // Oldest standard that passes with compiler at any optimization level, or "".
+    static std::string minimumStandard(const MatrixRow& row, const std::string& compiler);
+    static int report(const std::vector<MatrixRow>& rows, double totalSeconds, std::ostream& out);
+};
+
+#endif // DEMOMATRIX_H
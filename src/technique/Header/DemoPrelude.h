@@ -0,0 +1,31 @@
+#ifndef DEMOPRELUDE_H
+#define DEMOPRELUDE_H
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Shared prelude of the standard headers the demos use, precompiled once per
+// -std level and compiler. Demos are compiled with "-include prelude.h"; g++
+// picks up the neighbouring prelude.h.gch so the heavy headers are not parsed
+// again for every demo.
+class DemoPrelude {
+private:
+    std::filesystem::path directory;
+    std::string compiler;
+    std::mutex mutex;
+    std::map<std::string, std::filesystem::path> built;  // std flag -> prelude.h ("" if failed)
+public:
+    explicit DemoPrelude(std::filesystem::path directory = defaultDirectory(), std::string compiler = "g++");
+
+    static std::filesystem::path defaultDirectory();
+    static std::string headerText(const std::string& stdFlag);
+
+    // Returns the prelude header to pass to -include, building its PCH on first
+    // use. An empty path means no PCH is available and the demo should be
+    // compiled plainly.
+    std::filesystem::path ensureBuilt(const std::string& stdFlag);
+    bool buildAll(std::string& errors);
+};
+
+#endif // DEMOPRELUDE_H
@@ -0,0 +1,70 @@
+#ifndef DEMORUNNER_H
+#define DEMORUNNER_H
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DemoCache.h"
+#include "DemoPrelude.h"
+#include "PerfCounters.h"
+
+struct DemoResult {
+    bool compiled = false;
+    bool cacheHit = false;
+    bool usedPch = false;
+    int exitCode = -1;
+    int termSignal = 0;
+    bool timedOut = false;
+    std::string output;
+    std::string errorOutput;
+    std::string compileErrors;
+    double compileSeconds = 0.0;
+    double runSeconds = 0.0;
+    long compilerMaxRssKb = 0;      // peak RSS of the compiler (0 on a cache hit)
+    uintmax_t binaryBytes = 0;
+};
+
+// One timed run of a profiled demo binary (whole process: exec to exit).
+struct DemoRunSample {
+    double wallSeconds = 0.0;
+    double userSeconds = 0.0;
+    double systemSeconds = 0.0;
+    long maxRssKb = 0;
+    HardwareCounters counters;
+};
+
+struct DemoProfile {
+    std::string optFlag;
+    bool compiled = false;
+    std::string compileErrors;
+    double compileSeconds = 0.0;
+    std::string runError;  // why profiling stopped early, if it did
+    std::vector<DemoRunSample> samples;
+};
+
+// Compiles a demo (source fed to the compiler on stdin) into a private
+// temporary directory and runs it without a shell, capturing stdout/stderr in
+// memory under a wall-clock timeout and CPU/memory rlimits. When a DemoCache is given, binaries are reused across runs and
+// the compile step is skipped on a hit. With a DemoPrelude, misses compile
+// against the precompiled prelude and fall back to a plain compile if that
+// fails. Safe to call from several threads.
+class DemoRunner {
+private:
+    DemoCache* cache;
+    DemoPrelude* prelude;
+    std::string compiler;
+public:
+    // Level used when none is given: the newest, which builds every demo.
+    // --matrix reports the real minimum of each feature.
+    static constexpr const char* DEFAULT_STD_FLAG = "-std=c++23";
+
+    explicit DemoRunner(DemoCache* cache = nullptr, DemoPrelude* prelude = nullptr, std::string compiler = "g++");
+    DemoResult compileAndRun(const std::string& code) const;
+    // Explicit -std and optimization flags; an empty optFlag keeps the compiler default.
+    DemoResult compileAndRun(const std::string& code, const std::string& stdFlag, const std::string& optFlag) const;
+    // Builds the demo with optFlag (e.g. "-O2") and runs it `runs` times,
+    // recording rusage and, when permitted, hardware counters for each run.
+    // Bypasses the cache and prelude: the binary must match optFlag.
+    DemoProfile profile(const std::string& code, const std::string& optFlag, size_t runs) const;
+};
+
+#endif // DEMORUNNER_H
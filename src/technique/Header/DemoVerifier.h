@@ -0,0 +1,32 @@
+#ifndef DEMOVERIFIER_H
+#define DEMOVERIFIER_H
+#include <ostream>
+#include <string>
+#include <vector>
+#include "DemoRunner.h"
+#include "TechniqueManager.h"
+
+struct VerifyResult {
+    std::string name;
+    bool passed = false;
+    std::string mismatch;
+    DemoResult demo;
+};
+
+// Compiles and runs every demo of the catalog in parallel and compares the
+// program output with the expected_output stored in the catalog. Demos are
+// compiled exactly as shown, never against the precompiled prelude, so a
+// missing #include fails here rather than for a reader.
+class DemoVerifier {
+private:
+    const TechniqueManager& manager;
+    DemoCache* cache;
+    size_t threads;
+public:
+    DemoVerifier(const TechniqueManager& manager, DemoCache* cache = nullptr, size_t threads = 0);
+    std::vector<VerifyResult> run() const;
+    static int report(const std::vector<VerifyResult>& results, double totalSeconds, std::ostream& out);
+    static bool outputsMatch(const std::string& actual, const std::string& expected, std::string& mismatch);
+};
+
+#endif // DEMOVERIFIER_H
@@ -0,0 +1,30 @@
+#ifndef DETAILPAGE_H
+#define DETAILPAGE_H
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ICatalog.h"
+#include "Technique.h"
+
+// Detail screen of a technique, pre-rendered once into styled lines so that
+// redraws and page flips only copy strings into the frame.
+class DetailPage {
+public:
+    static std::vector<std::string> render(const Technique& tech);
+};
+
+// Rendered pages keyed by technique. Techniques are owned by the catalog, so
+// when it is replaced the cache must be pruned with retain() (or cleared)
+// while the old catalog is still alive, before any address can be reused.
+class DetailPageCache {
+private:
+    std::unordered_map<const Technique*, std::vector<std::string>> pages;
+public:
+    const std::vector<std::string>& get(const Technique& tech);
+    // Drops the pages of techniques that are not part of catalog.
+    void retain(const ICatalog& catalog);
+    void clear();
+    size_t size() const;
+};
+
+#endif // DETAILPAGE_H
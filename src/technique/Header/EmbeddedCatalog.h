@@ -0,0 +1,43 @@
+#ifndef EMBEDDEDCATALOG_H
+#define EMBEDDEDCATALOG_H
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "ICatalog.h"
+
+// One feature of the catalog compiled into the binary (CMT_EMBED_CATALOG).
+// The tables are generated from techniques.json by cmake/EmbedCatalog.cmake.
+struct EmbeddedFeature {
+    std::string_view name;
+    std::string_view definition;
+    std::string_view usage;
+    std::string_view syntax;
+    std::string_view demo_code;
+    std::string_view cpp_version;
+    std::string_view notes;
+    std::string_view expected_output;
+    std::span<const std::string_view> use_cases;
+    std::span<const std::string_view> best_practices;
+    std::span<const std::string_view> advantages;
+};
+
+// Catalog over the embedded tables: listing needs no file I/O and no heap
+// allocation; a Technique is only built when a feature is opened.
+class EmbeddedCatalog : public ICatalog {
+private:
+    mutable std::mutex materializeMutex;
+    mutable std::vector<std::unique_ptr<Technique>> materialized;
+public:
+    static std::span<const EmbeddedFeature> features();
+    static const EmbeddedCatalog& instance();
+
+    size_t size() const override;
+    std::string_view name(size_t index) const override;
+    std::string_view cppVersion(size_t index) const override;
+    const Technique& technique(size_t index) const override;
+    void visitText(size_t index, const TextVisitor& visit) const override;
+};
+
+#endif // EMBEDDEDCATALOG_H
@@ -0,0 +1,45 @@
+#ifndef ICATALOG_H
+#define ICATALOG_H
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include "Technique.h"
+
+// Heap footprint of a catalog, for comparing storage layouts.
+struct CatalogMemoryUsage {
+    size_t bytes = 0;        // payload bytes, excluding malloc's own headers
+    size_t allocations = 0;  // number of separate heap blocks
+};
+
+// Searchable text of a feature, by the field it comes from.
+enum class TextField { Name, Definition, UseCase, BestPractice, Advantage, DemoCode };
+using TextVisitor = std::function<void(TextField, std::string_view)>;
+
+// Read-only, indexable view of a loaded technique catalog. Names and versions
+// are cheap to list; technique() may build the full record on first access.
+// Implementations must allow technique() to be called from several threads.
+class ICatalog {
+public:
+    virtual ~ICatalog() = default;
+    virtual size_t size() const = 0;
+    virtual std::string_view name(size_t index) const = 0;
+    virtual std::string_view cppVersion(size_t index) const = 0;
+    virtual const Technique& technique(size_t index) const = 0;
+    virtual CatalogMemoryUsage memoryUsage() const { return {}; }
+    // Passes every searchable text of a feature to visit. Catalogs that build
+    // records on demand override this to read the text without keeping the
+    // record, so indexing a catalog does not materialize all of it.
+    virtual void visitText(size_t index, const TextVisitor& visit) const { visitText(technique(index), visit); }
+
+protected:
+    static void visitText(const Technique& tech, const TextVisitor& visit) {
+        visit(TextField::Name, tech.getName());
+        visit(TextField::Definition, tech.getDefinition());
+        for (const auto& text : tech.getUseCases()) visit(TextField::UseCase, text);
+        for (const auto& text : tech.getBestPractices()) visit(TextField::BestPractice, text);
+        for (const auto& text : tech.getAdvantages()) visit(TextField::Advantage, text);
+        visit(TextField::DemoCode, tech.getDemoCode());
+    }
+};
+
+#endif // ICATALOG_H
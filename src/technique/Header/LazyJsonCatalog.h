@@ -0,0 +1,45 @@
+#ifndef LAZYJSONCATALOG_H
+#define LAZYJSONCATALOG_H
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ICatalog.h"
+#include "MappedFile.h"
+
+// Catalog backed by a memory-mapped techniques.json. open() makes a single SAX
+// pass that keeps only each feature's name, version and byte range; the full
+// Technique is parsed from the mapping the first time it is requested, so
+// startup memory does not grow with the size of the feature bodies.
+//
+// The mapping is shared with the file. Before parsing, technique() checks
+// that the file was not truncated or rewritten since open(); if it was, the
+// feature is reported as changed instead of read from stale or missing pages
+// (hot reload replaces this catalog shortly after). A truncation racing that
+// check can still fault, so writers should save by rename.
+class LazyJsonCatalog : public ICatalog {
+private:
+    struct Entry {
+        std::string name;
+        size_t section = 0;   // index into sectionVersions
+        size_t begin = 0;     // byte range of the feature object in the file
+        size_t end = 0;
+    };
+
+    MappedFile file;
+    std::vector<std::string> sectionVersions;
+    std::vector<Entry> entries;
+    mutable std::mutex materializeMutex;
+    mutable std::vector<std::unique_ptr<Technique>> materialized;
+
+    std::unique_ptr<Technique> parse(size_t index) const;
+public:
+    bool open(const std::string& filename);
+    size_t size() const override;
+    std::string_view name(size_t index) const override;
+    std::string_view cppVersion(size_t index) const override;
+    const Technique& technique(size_t index) const override;
+    void visitText(size_t index, const TextVisitor& visit) const override;
+};
+
+#endif // LAZYJSONCATALOG_H
@@ -0,0 +1,43 @@
+#ifndef LIVECATALOG_H
+#define LIVECATALOG_H
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ICatalog.h"
+#include "ShardLoader.h"
+
+// Outcome of a reload, counted per feature id.
+struct CatalogDiff {
+    size_t added = 0;
+    size_t changed = 0;
+    size_t removed = 0;
+    size_t unchanged = 0;
+};
+
+// Catalog used for hot reload. Techniques are shared individually, so loading
+// a new version of the file carries every feature whose id and JSON content
+// are unchanged over from the previous snapshot (same object, same address)
+// and only parses the ones that were edited or added. A shard set (see
+// ShardLoader) is diffed the same way, after the priority merge.
+class LiveCatalog : public ICatalog {
+private:
+    struct Entry {
+        std::string id;
+        uint64_t hash = 0;  // of the feature's JSON and its section version
+        std::shared_ptr<const Technique> technique;
+    };
+
+    std::vector<Entry> entries;
+public:
+    bool load(const std::string& filename, const LiveCatalog* previous = nullptr, CatalogDiff* diff = nullptr);
+    bool loadShards(const std::vector<std::string>& shards, ShardLoadReport& report,
+                    const LiveCatalog* previous = nullptr, CatalogDiff* diff = nullptr);
+    size_t size() const override;
+    std::string_view name(size_t index) const override;
+    std::string_view cppVersion(size_t index) const override;
+    const Technique& technique(size_t index) const override;
+    std::string_view id(size_t index) const;
+};
+
+#endif // LIVECATALOG_H
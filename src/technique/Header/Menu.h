@@ -1,16 +1,34 @@
 #ifndef MENU_H
 #define MENU_H
 #include "TechniqueManager.h"
+#include "CatalogWatcher.h"
+#include "DemoCache.h"
+#include "DemoPrelude.h"
+#include "DetailPage.h"
+#include "TerminalFrame.h"
 
 class Menu {
 private:
     TechniqueManager& manager;
+    // Snapshot being displayed; swapped for the latest one between screens.
+    std::shared_ptr<const ICatalog> catalog;
+    DemoCache demoCache;
+    DemoPrelude demoPrelude;
+    bool usePch;
+    TerminalFrame frame;
+    DetailPageCache pages;
+    const CatalogWatcher* watcher;
+    size_t reportedFailures = 0;
+    bool refreshCatalog();
 public:
-    Menu(TechniqueManager& manager);
+    // watcher, if given, is asked for reload errors to show on the main list.
+    Menu(TechniqueManager& manager, bool usePch = true, const CatalogWatcher* watcher = nullptr);
     void show();
     void clearTerminal() const;
+    void showSearch();
     void showTechniqueDetail(const Technique& tech);
     void runDemo(const Technique& tech);
+    void profileDemo(const Technique& tech);
 };
 
 #endif // MENU_H 
\ No newline at end of file
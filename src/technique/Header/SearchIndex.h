@@ -0,0 +1,43 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ICatalog.h"
+
+struct SearchHit {
+    size_t index;
+    double score;
+};
+
+// Inverted index over name, definition, use cases, best practices, advantages
+// and demo code. Lookups go through a sorted term dictionary (exact and
+// prefix matches) and a trigram index over the terms (typo-tolerant matches
+// within a small edit distance), so a query never scans the techniques.
+class SearchIndex {
+private:
+    struct Posting {
+        uint32_t doc;
+        float weight;
+    };
+
+    size_t documentCount = 0;
+    std::vector<std::string> terms;                    // sorted
+    std::vector<std::vector<Posting>> postings;        // per term, sorted by doc
+    std::unordered_map<std::string, std::vector<uint32_t>> trigrams;  // trigram -> term ids
+
+    void addTrigrams(uint32_t termId);
+    std::vector<std::pair<uint32_t, int>> fuzzyTerms(const std::string& token) const;
+    double idf(uint32_t termId) const;
+public:
+    void build(const ICatalog& catalog);
+    std::vector<SearchHit> search(std::string_view query, size_t limit = 20) const;
+    size_t termCount() const;
+
+    static std::vector<std::string> tokenize(std::string_view text);
+    static int editDistance(std::string_view a, std::string_view b, int maxDistance);
+};
+
+#endif // SEARCHINDEX_H
@@ -0,0 +1,52 @@
+#ifndef SHARDLOADER_H
+#define SHARDLOADER_H
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Technique.h"
+
+struct ShardLoadReport {
+    size_t shards = 0;
+    size_t features = 0;      // after merging
+    size_t duplicates = 0;    // features dropped by the priority rule
+    std::string errors;       // one line per shard that could not be loaded
+};
+
+// One feature of the merged catalog, with what reload diffing needs.
+struct ShardEntry {
+    std::string id;
+    uint64_t hash = 0;  // TechniqueParser::contentHash
+    std::shared_ptr<const Technique> technique;
+};
+
+// Loads a catalog split over several files ("shards") that each use the
+// techniques.json layout, parsing them concurrently on a thread pool.
+//
+// The merge is deterministic whatever order the shards finish in: features
+// are grouped by version section (TechniqueParser::sectionBefore), then
+// ordered by shard path and by position within the shard. When several
+// features share an id, the one from the shard with the highest
+// "metadata.priority" (default 0) wins; on a tie the later shard in path
+// order wins, so an override file can be dropped next to the originals. The
+// winner takes the place of the first feature with that id.
+class ShardLoader {
+public:
+    // True for a directory or a glob pattern, i.e. anything expand() may turn into several files.
+    static bool isShardSet(const std::string& pattern);
+    // A directory (its *.json files) or a glob pattern, as a sorted list of files.
+    static std::vector<std::string> expand(const std::string& pattern);
+    // Returns the technique to keep for a feature whose id and content hash
+    // are unchanged, or null to parse it. Called from the parsing threads.
+    using Reuse = std::function<std::shared_ptr<const Technique>(const std::string& id, uint64_t hash)>;
+
+    // Fails, leaving techniques untouched, if any shard cannot be loaded.
+    static bool load(const std::vector<std::string>& shards, std::vector<Technique>& techniques,
+                     ShardLoadReport& report, size_t threads = 0);
+    // Same merge, keeping ids and hashes; features reuse() recognizes are not parsed again.
+    static bool loadEntries(const std::vector<std::string>& shards, std::vector<ShardEntry>& entries,
+                            ShardLoadReport& report, const Reuse& reuse = {}, size_t threads = 0);
+};
+
+#endif // SHARDLOADER_H
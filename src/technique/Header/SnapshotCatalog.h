@@ -0,0 +1,88 @@
+#ifndef SNAPSHOTCATALOG_H
+#define SNAPSHOTCATALOG_H
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ICatalog.h"
+#include "MappedFile.h"
+
+// Binary catalog snapshot ("techniques.cat"), written by catalog_compiler and
+// memory-mapped at startup. Layout, all integers in host byte order:
+//
+//   SnapshotHeader
+//   SnapshotRecord[recordCount]   fixed-size, one per technique
+//   StringRef[listCount]          items of the use case / best practice / advantage lists
+//   char blob[blobSize]           every string, back to back (not NUL-terminated)
+//
+// The header records the size, mtime and hash of the JSON it was built from so
+// a stale snapshot is detected and the caller can fall back to JSON.
+class SnapshotCatalog : public ICatalog {
+public:
+    static constexpr char MAGIC[8] = {'C', 'M', 'T', 'C', 'A', 'T', '\0', '\0'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    enum Field { NAME, DEFINITION, USAGE, SYNTAX, DEMO_CODE, CPP_VERSION, NOTES, DEMO_NOTE, EXPECTED_OUTPUT, FIELD_COUNT };
+    enum List { USE_CASES, BEST_PRACTICES, ADVANTAGES, LIST_COUNT };
+
+    struct StringRef {
+        uint64_t offset;
+        uint64_t length;
+    };
+    struct ListRef {
+        uint64_t first;
+        uint64_t count;
+    };
+    struct SnapshotRecord {
+        StringRef fields[FIELD_COUNT];
+        ListRef lists[LIST_COUNT];
+    };
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t byteOrder;
+        uint64_t recordCount;
+        uint64_t listItemCount;
+        uint64_t blobSize;
+        uint64_t recordsOffset;
+        uint64_t listsOffset;
+        uint64_t blobOffset;
+        uint64_t sourceSize;
+        int64_t sourceMtime;
+        uint64_t sourceHash;
+        uint64_t tableChecksum;   // records + list table, verified on every open
+        uint64_t blobChecksum;    // string blob, verified by verifyBlob()
+        uint64_t headerChecksum;  // all header fields above
+    };
+
+    // Opens the snapshot and checks it against sourcePath (if that file exists).
+    bool open(const std::string& snapshotPath, const std::string& sourcePath);
+    bool verifyBlob() const;
+    static bool write(const ICatalog& catalog, const std::string& snapshotPath, const std::string& sourcePath);
+
+    size_t size() const override;
+    std::string_view name(size_t index) const override;
+    std::string_view cppVersion(size_t index) const override;
+    const Technique& technique(size_t index) const override;
+    void visitText(size_t index, const TextVisitor& visit) const override;
+
+    std::string_view field(size_t index, Field field) const;
+    size_t listSize(size_t index, List list) const;
+    std::string_view listItem(size_t index, List list, size_t item) const;
+
+private:
+    MappedFile file;
+    const SnapshotHeader* header = nullptr;
+    const SnapshotRecord* records = nullptr;
+    const StringRef* listItems = nullptr;
+    const char* blob = nullptr;
+    mutable std::mutex materializeMutex;
+    mutable std::vector<std::unique_ptr<Technique>> materialized;
+
+    std::string_view resolve(const StringRef& ref) const;
+    std::vector<std::string> listToVector(size_t index, List list) const;
+};
+
+#endif // SNAPSHOTCATALOG_H
@@ -1,16 +1,70 @@
 #ifndef TECHNIQUEMANAGER_H
 #define TECHNIQUEMANAGER_H
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <string_view>
+#include "ICatalog.h"
+#include "LiveCatalog.h"
+#include "SearchIndex.h"
+#include "ShardLoader.h"
 #include "Technique.h"
 
 class TechniqueManager {
 private:
-    std::vector<Technique> techniques;
+    // Published RCU-style: readers take a snapshot with getCatalog() and keep
+    // using it while a reload swaps in a new one.
+    std::atomic<std::shared_ptr<const ICatalog>> catalog;
+    std::mutex reloadMutex;
+    // Built on the first search (or by prepareSearch) and rebuilt whenever a
+    // different catalog is loaded.
+    mutable std::mutex searchMutex;
+    mutable std::shared_ptr<const ICatalog> indexedCatalog;
+    mutable SearchIndex searchIndex;
+
+    void buildIndexLocked(const std::shared_ptr<const ICatalog>& snapshot) const;
 public:
     bool loadFromJson(const std::string& filename);
-    const std::vector<Technique>& getTechniques() const;
+    // Streaming loader: indexes names/versions only, bodies are parsed on demand.
+    bool loadFromJsonLazy(const std::string& filename);
+    // Compact arena/interned/SoA storage (see ArenaCatalog).
+    bool loadFromJsonArena(const std::string& filename);
+    // Maps a binary snapshot built by catalog_compiler; fails if it is missing,
+    // corrupt or older than sourcePath.
+    bool loadFromSnapshot(const std::string& snapshotPath, const std::string& sourcePath);
+    // Catalog split over a directory or glob of JSON shards (see ShardLoader),
+    // published as a LiveCatalog: reloading the set reuses every unchanged
+    // feature of the current one. The current catalog stays on failure.
+    bool loadFromShards(const std::string& pattern, ShardLoadReport& report, CatalogDiff* diff = nullptr);
+    // Snapshot next to the JSON if it is up to date, otherwise the JSON itself.
+    bool loadCatalog(const std::string& jsonPath);
+    static std::string snapshotPathFor(const std::string& jsonPath);
+    // Catalog compiled into the binary; false unless built with CMT_EMBED_CATALOG.
+    bool loadEmbedded();
+    // Re-reads filename into a LiveCatalog, reusing unchanged features of the
+    // current one, and publishes it. The current catalog stays on failure.
+    // baseline is diffed against instead when the current catalog is not a
+    // LiveCatalog (e.g. the snapshot the program started from).
+    bool reloadFromJson(const std::string& filename, CatalogDiff* diff = nullptr,
+                        const LiveCatalog* baseline = nullptr);
+    std::shared_ptr<const ICatalog> getCatalog() const;
+    // Shortcuts on the current catalog. Names and versions are copied out;
+    // the getTechnique() reference is only stable while no reload can run.
+    // Readers that outlive a reload hold getCatalog() instead.
+    size_t size() const;
+    std::string nameAt(size_t index) const;
+    std::string versionAt(size_t index) const;
+    const Technique& getTechnique(size_t index) const;
+    // Ranked full-text search; tolerates prefixes and small typos.
+    std::vector<SearchHit> search(std::string_view query, size_t limit = 20) const;
+    // Same, against a snapshot the caller already holds (hits index into it).
+    std::vector<SearchHit> search(const std::shared_ptr<const ICatalog>& snapshot,
+                                  std::string_view query, size_t limit = 20) const;
+    // Builds the search index for snapshot now, so a later search does not pay for it.
+    void prepareSearch(const std::shared_ptr<const ICatalog>& snapshot) const;
     static std::string joinVector(const std::vector<std::string>& vec, const std::string& sep);
 };
 
-#endif // TECHNIQUEMANAGER_H 
\ No newline at end of file
+#endif // TECHNIQUEMANAGER_H 
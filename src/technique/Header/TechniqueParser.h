@@ -0,0 +1,31 @@
+#ifndef TECHNIQUEPARSER_H
+#define TECHNIQUEPARSER_H
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+#include "Technique.h"
+
+// Converts one entry of a "features" array into a Technique.
+class TechniqueParser {
+public:
+    // Version sections under "cpp_modern_features": every object member with a
+    // "features" array ("metadata" and the like are skipped), in display order.
+    static std::vector<std::string> sectionKeys(const nlohmann::json& featuresRoot);
+    // Display order of sections: by the standard named in the key (cpp98 <
+    // cpp17 < cpp2c < cpp26), keys without a number last, then by key.
+    static bool sectionBefore(std::string_view a, std::string_view b);
+    // Year of the first standard level named in text: "cpp17_features" and
+    // "-std=c++17" -> 2017, "cpp98" -> 1998, "gnu++2b" -> 2023, "cpp2026" ->
+    // 2026; 0 if there is none. cmake/EmbedCatalog.cmake applies the same rule.
+    static int standardYear(std::string_view text);
+
+    static Technique fromJson(const nlohmann::json& item, const std::string& cpp_version);
+    // Identifies a feature's content for reload diffing: its JSON and section version.
+    static uint64_t contentHash(const nlohmann::json& item, const std::string& cpp_version);
+    static std::string syntaxText(const nlohmann::json& item);
+    static std::string notesText(const nlohmann::json& item);
+};
+
+#endif // TECHNIQUEPARSER_H
@@ -0,0 +1,19 @@
+#ifndef VECTORCATALOG_H
+#define VECTORCATALOG_H
+#include <vector>
+#include "ICatalog.h"
+
+// Fully materialized catalog, as produced by TechniqueManager::loadFromJson.
+class VectorCatalog : public ICatalog {
+private:
+    std::vector<Technique> techniques;
+public:
+    explicit VectorCatalog(std::vector<Technique> techniques);
+    size_t size() const override;
+    std::string_view name(size_t index) const override;
+    std::string_view cppVersion(size_t index) const override;
+    const Technique& technique(size_t index) const override;
+    CatalogMemoryUsage memoryUsage() const override;
+};
+
+#endif // VECTORCATALOG_H
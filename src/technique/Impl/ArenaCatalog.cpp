@@ -0,0 +1,273 @@
+#include "../Header/ArenaCatalog.h"
+#include "../Header/TechniqueManager.h"
+#include "../Header/TechniqueParser.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+    template <typename T>
+    void addColumn(CatalogMemoryUsage& usage, const std::vector<T>& column) {
+        if (column.capacity() == 0) return;
+        usage.bytes += column.capacity() * sizeof(T);
+        ++usage.allocations;
+    }
+
+    std::string optionalString(const json& item, const char* key) {
+        return item.contains(key) ? item[key].get<std::string>() : std::string();
+    }
+}
+
+void* ArenaCatalog::CountingResource::do_allocate(size_t size, size_t alignment) {
+    bytes += size;
+    ++allocations;
+    return ::operator new(size, std::align_val_t(alignment));
+}
+
+void ArenaCatalog::CountingResource::do_deallocate(void* p, size_t size, size_t alignment) {
+    ::operator delete(p, size, std::align_val_t(alignment));
+}
+
+bool ArenaCatalog::CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+std::string_view ArenaCatalog::store(std::pmr::memory_resource& arena, std::string_view text) {
+    if (text.empty()) return {};
+    char* copy = static_cast<char*>(arena.allocate(text.size(), 1));
+    std::memcpy(copy, text.data(), text.size());
+    return {copy, text.size()};
+}
+
+uint32_t ArenaCatalog::intern(std::string_view text) {
+    auto it = internIds.find(text);
+    if (it != internIds.end()) return it->second;
+    std::string_view stored = store(*hotArena, text);
+    uint32_t id = static_cast<uint32_t>(interned.size());
+    interned.push_back(stored);
+    internIds.emplace(stored, id);
+    return id;
+}
+
+std::string_view ArenaCatalog::internedText(uint32_t id) const {
+    return id == NONE ? std::string_view() : interned[id];
+}
+
+bool ArenaCatalog::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) return false;
+    json j = json::parse(file, nullptr, false);
+    if (j.is_discarded() || !j.contains("cpp_modern_features")) return false;
+    const auto& features_root = j["cpp_modern_features"];
+
+    // Size the arenas up front: names and (an upper bound of) the interned
+    // values go to the hot arena, every other text to the cold one.
+    size_t hotBytes = 1;
+    size_t coldBytes = 1;
+    std::vector<std::string> sectionKeys = TechniqueParser::sectionKeys(features_root);
+    for (const auto& version_key : sectionKeys) {
+        const auto& section = features_root[version_key];
+        hotBytes += section.value("version", "").size();
+        for (const auto& item : section["features"]) {
+            hotBytes += item.value("name", "").size() + optionalString(item, "category").size() +
+                        optionalString(item, "complexity_level").size() +
+                        optionalString(item, "key_improvements").size();
+            coldBytes += item.value("definition", "").size() + TechniqueParser::syntaxText(item).size();
+            if (item.contains("complete_demo")) {
+                coldBytes += item["complete_demo"].value("code", "").size() +
+                             item["complete_demo"].value("expected_output", "").size();
+            }
+            for (const char* key : {"primary_use_cases", "best_practices", "advantages"}) {
+                if (!item.contains(key)) continue;
+                for (const auto& entry : item[key]) coldBytes += entry.get<std::string>().size();
+            }
+        }
+    }
+    hotArena.emplace(hotBytes, &upstream);
+    coldArena.emplace(coldBytes, &upstream);
+
+    auto appendList = [this](const json& item, const char* key, std::vector<ListRange>& ranges) {
+        if (!item.contains(key)) {
+            ranges.push_back({NONE, 0});
+            return;
+        }
+        ListRange range{static_cast<uint32_t>(listItems.size()), 0};
+        for (const auto& entry : item[key]) {
+            listItems.push_back(store(*coldArena, entry.get<std::string>()));
+            ++range.count;
+        }
+        ranges.push_back(range);
+    };
+
+    for (const auto& version_key : sectionKeys) {
+        const auto& section = features_root[version_key];
+        uint32_t version = intern(section.value("version", ""));
+        for (const auto& item : section["features"]) {
+            names.push_back(store(*hotArena, item.value("name", "")));
+            versions.push_back(version);
+            categories.push_back(item.contains("category") ? intern(optionalString(item, "category")) : NONE);
+            levels.push_back(item.contains("complexity_level") ? intern(optionalString(item, "complexity_level")) : NONE);
+            improvements.push_back(item.contains("key_improvements") ? intern(optionalString(item, "key_improvements")) : NONE);
+            definitions.push_back(store(*coldArena, item.value("definition", "")));
+            syntaxes.push_back(store(*coldArena, TechniqueParser::syntaxText(item)));
+            std::string demo_code;
+            std::string expected_output;
+            if (item.contains("complete_demo")) {
+                demo_code = item["complete_demo"].value("code", "");
+                expected_output = item["complete_demo"].value("expected_output", "");
+            }
+            demoCodes.push_back(store(*coldArena, demo_code));
+            expectedOutputs.push_back(store(*coldArena, expected_output));
+            appendList(item, "primary_use_cases", useCaseRanges);
+            appendList(item, "best_practices", bestPracticeRanges);
+            appendList(item, "advantages", advantageRanges);
+        }
+    }
+    materialized.resize(names.size());
+    return true;
+}
+
+size_t ArenaCatalog::size() const {
+    return names.size();
+}
+
+std::string_view ArenaCatalog::name(size_t index) const {
+    return names[index];
+}
+
+std::string_view ArenaCatalog::cppVersion(size_t index) const {
+    return internedText(versions[index]);
+}
+
+std::string_view ArenaCatalog::category(size_t index) const {
+    return internedText(categories[index]);
+}
+
+std::string_view ArenaCatalog::level(size_t index) const {
+    return internedText(levels[index]);
+}
+
+std::string_view ArenaCatalog::definition(size_t index) const {
+    return definitions[index];
+}
+
+std::string_view ArenaCatalog::syntax(size_t index) const {
+    return syntaxes[index];
+}
+
+std::string_view ArenaCatalog::demoCode(size_t index) const {
+    return demoCodes[index];
+}
+
+std::string_view ArenaCatalog::expectedOutput(size_t index) const {
+    return expectedOutputs[index];
+}
+
+std::span<const std::string_view> ArenaCatalog::list(const std::vector<ListRange>& ranges, size_t index) const {
+    const ListRange& range = ranges[index];
+    if (range.first == NONE) return {};
+    return std::span<const std::string_view>(listItems).subspan(range.first, range.count);
+}
+
+std::span<const std::string_view> ArenaCatalog::useCases(size_t index) const {
+    return list(useCaseRanges, index);
+}
+
+std::span<const std::string_view> ArenaCatalog::bestPractices(size_t index) const {
+    return list(bestPracticeRanges, index);
+}
+
+std::span<const std::string_view> ArenaCatalog::advantages(size_t index) const {
+    return list(advantageRanges, index);
+}
+
+size_t ArenaCatalog::internedCount() const {
+    return interned.size();
+}
+
+const Technique& ArenaCatalog::technique(size_t index) const {
+    std::lock_guard<std::mutex> lock(materializeMutex);
+    if (!materialized[index]) {
+        auto toVector = [](std::span<const std::string_view> items) {
+            return std::vector<std::string>(items.begin(), items.end());
+        };
+        std::vector<std::string> use_cases = toVector(useCases(index));
+        std::string usage;
+        if (useCaseRanges[index].first != NONE) usage = "- " + TechniqueManager::joinVector(use_cases, "\n- ");
+        // Notes are rebuilt from the interned values instead of being stored per record.
+        std::string notes;
+        if (categories[index] != NONE) notes += "Category: " + std::string(category(index)) + "\n";
+        if (levels[index] != NONE) notes += "Level: " + std::string(level(index)) + "\n";
+        if (improvements[index] != NONE) notes += "Improvements: " + std::string(internedText(improvements[index])) + "\n";
+        materialized[index] = std::make_unique<Technique>(
+            std::string(name(index)), std::string(definition(index)), std::move(usage),
+            std::string(syntax(index)), std::string(demoCode(index)), std::string(cppVersion(index)),
+            std::move(notes), std::string(), std::move(use_cases), toVector(bestPractices(index)),
+            toVector(advantages(index)), std::string(expectedOutput(index)));
+    }
+    return *materialized[index];
+}
+
+void ArenaCatalog::visitText(size_t index, const TextVisitor& visit) const {
+    visit(TextField::Name, name(index));
+    visit(TextField::Definition, definition(index));
+    for (std::string_view text : useCases(index)) visit(TextField::UseCase, text);
+    for (std::string_view text : bestPractices(index)) visit(TextField::BestPractice, text);
+    for (std::string_view text : advantages(index)) visit(TextField::Advantage, text);
+    visit(TextField::DemoCode, demoCode(index));
+}
+
+CatalogMemoryUsage ArenaCatalog::memoryUsage() const {
+    CatalogMemoryUsage usage;
+    usage.bytes = upstream.bytes;
+    usage.allocations = upstream.allocations;
+    addColumn(usage, interned);
+    addColumn(usage, names);
+    addColumn(usage, versions);
+    addColumn(usage, categories);
+    addColumn(usage, levels);
+    addColumn(usage, improvements);
+    addColumn(usage, definitions);
+    addColumn(usage, syntaxes);
+    addColumn(usage, demoCodes);
+    addColumn(usage, expectedOutputs);
+    addColumn(usage, listItems);
+    addColumn(usage, useCaseRanges);
+    addColumn(usage, bestPracticeRanges);
+    addColumn(usage, advantageRanges);
+    addColumn(usage, materialized);
+    // unordered_map: bucket array plus one node (next pointer, value, cached hash) per entry.
+    usage.bytes += internIds.bucket_count() * sizeof(void*) +
+                   internIds.size() * (sizeof(void*) + sizeof(std::pair<const std::string_view, uint32_t>) + sizeof(size_t));
+    usage.allocations += 1 + internIds.size();
+    return usage;
+}
+
+bool ArenaCatalog::writeMemoryReport(const std::string& filename, std::ostream& out) {
+    TechniqueManager eager;
+    ArenaCatalog arena;
+    if (!eager.loadFromJson(filename) || !arena.load(filename)) return false;
+    CatalogMemoryUsage vectorUsage = eager.getCatalog()->memoryUsage();
+    CatalogMemoryUsage arenaUsage = arena.memoryUsage();
+
+    out << "Catalog memory report for " << filename << " (" << arena.size() << " techniques)\n\n";
+    out << std::left << std::setw(34) << "Layout" << std::right << std::setw(14) << "Heap bytes"
+        << std::setw(14) << "Allocations" << "\n";
+    out << std::left << std::setw(34) << "Technique (std::string fields)" << std::right
+        << std::setw(14) << vectorUsage.bytes << std::setw(14) << vectorUsage.allocations << "\n";
+    out << std::left << std::setw(34) << "Arena + interning + SoA columns" << std::right
+        << std::setw(14) << arenaUsage.bytes << std::setw(14) << arenaUsage.allocations << "\n\n";
+    auto saving = [](size_t before, size_t after) {
+        return before == 0 ? 0.0 : 100.0 * (static_cast<double>(before) - static_cast<double>(after)) / before;
+    };
+    out << std::fixed << std::setprecision(1)
+        << "Saved " << saving(vectorUsage.bytes, arenaUsage.bytes) << "% of bytes and "
+        << saving(vectorUsage.allocations, arenaUsage.allocations) << "% of allocations; "
+        << arena.internedCount() << " distinct interned values.\n"
+        << "Byte counts exclude malloc headers, which add ~16 bytes per allocation.\n";
+    return true;
+}
@@ -0,0 +1,505 @@
+#include "../Header/CatalogServer.h"
+#include "../Header/DemoRunner.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <nlohmann/json.hpp>
+#include "Trace.h"
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // epoll user data for the non-connection descriptors; connection ids start above.
+    constexpr uint64_t LISTEN_ID = 1;
+    constexpr uint64_t WAKE_ID = 2;
+    constexpr uint64_t SIGNAL_ID = 3;
+    constexpr size_t MAX_IOVECS = 64;
+    constexpr size_t SEARCH_LIMIT = 20;
+
+    std::shared_ptr<const std::string> serialize(const nlohmann::json& body) {
+        auto text = std::make_shared<std::string>(body.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+        text->push_back('\n');
+        return text;
+    }
+
+    bool parseIndex(const std::string& text, size_t& index) {
+        if (text.empty() || text.size() > 18 ||
+            !std::all_of(text.begin(), text.end(), [](unsigned char c) { return c >= '0' && c <= '9'; })) {
+            return false;
+        }
+        index = std::stoull(text);
+        return true;
+    }
+
+    void closeFd(int& fd) {
+#ifdef __linux__
+        if (fd >= 0) ::close(fd);
+#endif
+        fd = -1;
+    }
+}
+
+CatalogServer::CatalogServer(TechniqueManager& manager, std::string address, bool usePch, size_t workers)
+    : manager(manager), address(std::move(address)), usePch(usePch),
+      workerCount(workers ? workers : ThreadPool::defaultThreadCount()),
+      maxPendingJobs(4 * (workers ? workers : ThreadPool::defaultThreadCount())) {
+    sigemptyset(&previousMask);
+#ifdef __linux__
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, &previousMask);
+#endif
+}
+
+CatalogServer::~CatalogServer() {
+    shutdown();
+#ifdef __linux__
+    pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+#endif
+}
+
+CatalogServer::Buffer CatalogServer::error(const std::string& message) {
+    return serialize({{"ok", false}, {"error", message}});
+}
+
+bool CatalogServer::listen() {
+#ifdef __linux__
+    size_t port = 0;
+    if (parseIndex(address, port)) {
+        if (port == 0 || port > 65535) return false;
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) return false;
+        int on = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) return false;
+    } else {
+        sockaddr_un addr = {};
+        if (address.empty() || address.size() >= sizeof(addr.sun_path)) return false;
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) return false;
+        // A socket left behind by a server that crashed; never remove anything else.
+        struct stat info;
+        if (lstat(address.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) unlink(address.c_str());
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, address.c_str(), address.size());
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) return false;
+        socketPath = address;
+    }
+    return ::listen(listenFd, SOMAXCONN) == 0;
+#else
+    return false;
+#endif
+}
+
+void CatalogServer::refreshCatalog() {
+    auto latest = manager.getCatalog();
+    if (latest == catalog) return;
+    // In-flight RUN jobs hold their own reference to the old snapshot.
+    catalog = std::move(latest);
+    listResponse.reset();
+    detailResponses.assign(catalog ? catalog->size() : 0, nullptr);
+    // Index the new snapshot ahead of the first SEARCH, off the event loop.
+    if (catalog && workers) {
+        workers->submit([this, snapshot = catalog] {
+            if (cancelled) return;
+            TraceSpan span("server.indexCatalog");
+            manager.prepareSearch(snapshot);
+        });
+    }
+}
+
+CatalogServer::Buffer CatalogServer::listBody() {
+    if (!listResponse) {
+        nlohmann::json items = nlohmann::json::array();
+        for (size_t i = 0; i < catalog->size(); ++i) {
+            items.push_back({{"index", i}, {"name", catalog->name(i)}, {"version", catalog->cppVersion(i)}});
+        }
+        listResponse = serialize({{"ok", true}, {"techniques", std::move(items)}});
+    }
+    return listResponse;
+}
+
+CatalogServer::Buffer CatalogServer::detailBody(size_t index) {
+    Buffer& cached = detailResponses[index];
+    if (!cached) {
+        const Technique& tech = catalog->technique(index);
+        cached = serialize({
+            {"ok", true},
+            {"index", index},
+            {"name", tech.getName()},
+            {"cpp_version", tech.getCppVersion()},
+            {"definition", tech.getDefinition()},
+            {"usage", tech.getUsage()},
+            {"syntax", tech.getSyntax()},
+            {"notes", tech.getNotes()},
+            {"demo_code", tech.getDemoCode()},
+            {"demo_note", tech.getDemoNote()},
+            {"expected_output", tech.getExpectedOutput()},
+            {"use_cases", tech.getUseCases()},
+            {"best_practices", tech.getBestPractices()},
+            {"advantages", tech.getAdvantages()},
+        });
+    }
+    return cached;
+}
+
+void CatalogServer::accept() {
+#ifdef __linux__
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;  // EAGAIN, or out of descriptors until a client leaves
+        }
+        uint64_t id = nextConnectionId++;
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = id;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+        Connection& connection = connections[id];
+        connection.fd = fd;
+        connection.interest = event.events;
+    }
+#endif
+}
+
+void CatalogServer::readFrom(uint64_t id, Connection& connection) {
+#ifdef __linux__
+    char buffer[16384];
+    while (!connection.closing && !backlogged(connection)) {
+        ssize_t n = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0) {
+            // Peer is gone (or half-closed): answer what was asked, then close.
+            connection.closing = true;
+            break;
+        }
+        connection.input.append(buffer, static_cast<size_t>(n));
+        handleInput(id, connection);
+    }
+    flush(id, connection);
+#endif
+}
+
+void CatalogServer::handleInput(uint64_t id, Connection& connection) {
+    size_t start = 0;
+    for (size_t end; !connection.closing && !backlogged(connection) &&
+                     (end = connection.input.find('\n', start)) != std::string::npos; start = end + 1) {
+        std::string line = connection.input.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        handleLine(id, connection, line);
+    }
+    connection.input.erase(0, start);
+    if (connection.input.size() > MAX_LINE && connection.input.find('\n') == std::string::npos) {
+        connection.output.push_back({connection.nextSequence++, error("request line too long")});
+        connection.closing = true;
+    }
+}
+
+bool CatalogServer::backlogged(const Connection& connection) {
+    return connection.output.size() >= MAX_QUEUED_REPLIES;
+}
+
+void CatalogServer::handleLine(uint64_t id, Connection& connection, const std::string& line) {
+    size_t space = line.find(' ');
+    std::string command = line.substr(0, space);
+    std::string argument = space == std::string::npos ? "" : line.substr(space + 1);
+    std::transform(command.begin(), command.end(), command.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    TraceSpan span("server.request");
+
+    refreshCatalog();
+    auto reply = [&](Buffer data) { connection.output.push_back({connection.nextSequence++, std::move(data)}); };
+    size_t index = 0;
+    try {
+        if (command.empty()) {
+            return;
+        } else if (command == "QUIT") {
+            connection.closing = true;
+        } else if (!catalog) {
+            reply(error("no catalog loaded"));
+        } else if (command == "LIST") {
+            reply(listBody());
+        } else if (command == "DETAIL" || command == "RUN") {
+            if (!parseIndex(argument, index) || index >= catalog->size()) {
+                reply(error("expected an index below " + std::to_string(catalog->size())));
+            } else if (command == "DETAIL") {
+                reply(detailBody(index));
+            } else {
+                submit(id, connection, command, [this, index, snapshot = catalog] { return runBody(*snapshot, index); });
+            }
+        } else if (command == "SEARCH") {
+            // Building the index for a new snapshot parses every feature; keep it off the loop.
+            submit(id, connection, command, [this, argument, snapshot = catalog] {
+                nlohmann::json hits = nlohmann::json::array();
+                for (const auto& hit : manager.search(snapshot, argument, SEARCH_LIMIT)) {
+                    hits.push_back({{"index", hit.index}, {"name", snapshot->name(hit.index)},
+                                    {"version", snapshot->cppVersion(hit.index)}, {"score", hit.score}});
+                }
+                return serialize({{"ok", true}, {"hits", std::move(hits)}});
+            });
+        } else {
+            reply(error("unknown command: " + command));
+        }
+    } catch (const std::exception& e) {
+        // A lazily loaded feature can fail to parse; one bad request must not stop the server.
+        reply(error(command + " failed: " + e.what()));
+    }
+}
+
+void CatalogServer::submit(uint64_t id, Connection& connection, const std::string& command, std::function<Buffer()> job) {
+    if (pendingJobs >= maxPendingJobs) {
+        connection.output.push_back({connection.nextSequence++, error("busy: too many requests queued")});
+        return;
+    }
+    uint64_t sequence = connection.nextSequence++;
+    connection.output.push_back({sequence, nullptr});
+    ++pendingJobs;
+    workers->submit([this, id, sequence, command, job = std::move(job)] {
+        Buffer data;
+        if (cancelled) {
+            data = error(command + " cancelled: the server is shutting down");
+        } else {
+            try {
+                data = job();
+            } catch (const std::exception& e) {
+                // The slot must still be filled, or every later reply on the connection stalls.
+                data = error(command + " failed: " + e.what());
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            completions.push_back({id, sequence, std::move(data)});
+        }
+#ifdef __linux__
+        uint64_t one = 1;
+        while (write(wakeFd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+#endif
+    });
+}
+
+CatalogServer::Buffer CatalogServer::runBody(const ICatalog& snapshot, size_t index) {
+    TraceSpan span("server.run");
+    DemoRunner runner(&demoCache, usePch ? &demoPrelude : nullptr);
+    DemoResult result = runner.compileAndRun(snapshot.technique(index).getDemoCode());
+    return serialize({
+        {"ok", true},
+        {"index", index},
+        {"compiled", result.compiled},
+        {"cache_hit", result.cacheHit},
+        {"exit_code", result.exitCode},
+        {"signal", result.termSignal},
+        {"timed_out", result.timedOut},
+        {"output", result.output},
+        {"error_output", result.errorOutput},
+        {"compile_errors", result.compileErrors},
+        {"compile_seconds", result.compileSeconds},
+        {"run_seconds", result.runSeconds},
+    });
+}
+
+void CatalogServer::drainCompletions() {
+#ifdef __linux__
+    uint64_t count;
+    while (read(wakeFd, &count, sizeof(count)) < 0 && errno == EINTR) {}
+#endif
+    std::vector<Completion> done;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        done.swap(completions);
+    }
+    for (auto& completion : done) {
+        --pendingJobs;
+        auto it = connections.find(completion.connection);
+        if (it == connections.end()) continue;  // client left before its demo finished
+        for (auto& slot : it->second.output) {
+            if (slot.sequence == completion.sequence) {
+                slot.data = std::move(completion.data);
+                break;
+            }
+        }
+        flush(it->first, it->second);
+    }
+}
+
+void CatalogServer::flush(uint64_t id, Connection& connection) {
+#ifdef __linux__
+    for (;;) {
+        // Gather the ready prefix of the queue; cached buffers go out as-is.
+        while (!connection.output.empty() && connection.output.front().data) {
+            iovec vectors[MAX_IOVECS];
+            size_t count = 0;
+            for (auto it = connection.output.begin(); it != connection.output.end() && it->data && count < MAX_IOVECS; ++it) {
+                size_t skip = count == 0 ? connection.sentOfFront : 0;
+                vectors[count++] = {const_cast<char*>(it->data->data()) + skip, it->data->size() - skip};
+            }
+            msghdr message = {};
+            message.msg_iov = vectors;
+            message.msg_iovlen = count;
+            ssize_t n = sendmsg(connection.fd, &message, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (n < 0) {
+                close(id);
+                return;
+            }
+            size_t sent = static_cast<size_t>(n);
+            while (sent > 0) {
+                size_t left = connection.output.front().data->size() - connection.sentOfFront;
+                if (sent < left) {
+                    connection.sentOfFront += sent;
+                    break;
+                }
+                sent -= left;
+                connection.sentOfFront = 0;
+                connection.output.pop_front();
+            }
+        }
+        // Requests held back by backpressure resume once the queue has drained.
+        if (connection.closing || backlogged(connection) || connection.input.find('\n') == std::string::npos) break;
+        handleInput(id, connection);
+    }
+    if (connection.closing && connection.output.empty()) {
+        close(id);
+        return;
+    }
+    updateInterest(id, connection);
+#endif
+}
+
+void CatalogServer::updateInterest(uint64_t id, Connection& connection) {
+#ifdef __linux__
+    bool wantWrite = !connection.output.empty() && connection.output.front().data;
+    // A closing connection waits only for its pending replies; a backlogged
+    // one is not read until its client has taken some of them.
+    bool wantRead = !connection.closing && !backlogged(connection);
+    uint32_t interest = (wantRead ? uint32_t{EPOLLIN | EPOLLRDHUP} : 0u) | (wantWrite ? uint32_t{EPOLLOUT} : 0u);
+    if (interest == connection.interest) return;
+    connection.interest = interest;
+    epoll_event event = {};
+    event.events = interest;
+    event.data.u64 = id;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+#endif
+}
+
+void CatalogServer::close(uint64_t id) {
+    auto it = connections.find(id);
+    if (it == connections.end()) return;
+#ifdef __linux__
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+#endif
+    closeFd(it->second.fd);
+    connections.erase(it);
+}
+
+void CatalogServer::shutdown() {
+    // Queued jobs answer with an error instead of running; jobs already
+    // running finish (a demo is bounded by its timeout). Joining the pool
+    // must come first: jobs signal wakeFd and reference this object.
+    cancelled = true;
+    for (auto& [id, connection] : connections) connection.closing = true;
+    workers.reset();
+    // Hand out those replies where the socket still takes them without blocking.
+    if (wakeFd >= 0) drainCompletions();
+    while (!connections.empty()) close(connections.begin()->first);
+    closeFd(listenFd);
+    closeFd(wakeFd);
+    closeFd(signalFd);
+    closeFd(epollFd);
+#ifdef __linux__
+    if (!socketPath.empty()) unlink(socketPath.c_str());
+#endif
+    socketPath.clear();
+}
+
+bool CatalogServer::run(std::string& errors) {
+#ifdef __linux__
+    if (!listen()) {
+        errors += "cannot listen on " + address + ": " + std::strerror(errno) + "\n";
+        shutdown();
+        return false;
+    }
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    signalFd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    bool ready = epollFd >= 0 && wakeFd >= 0 && signalFd >= 0;
+    for (auto [fd, id] : {std::pair{listenFd, LISTEN_ID}, std::pair{wakeFd, WAKE_ID}, std::pair{signalFd, SIGNAL_ID}}) {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        ready = ready && epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+    if (!ready) {
+        errors += std::string("cannot set up the event loop: ") + std::strerror(errno) + "\n";
+        shutdown();
+        return false;
+    }
+    workers = std::make_unique<ThreadPool>(workerCount);
+    refreshCatalog();
+
+    epoll_event events[64];
+    bool stopping = false;
+    while (!stopping) {
+        int count = epoll_wait(epollFd, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            errors += std::string("epoll_wait: ") + std::strerror(errno) + "\n";
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            uint64_t id = events[i].data.u64;
+            if (id == LISTEN_ID) {
+                accept();
+            } else if (id == WAKE_ID) {
+                drainCompletions();
+            } else if (id == SIGNAL_ID) {
+                // Consume it: left pending, it would be delivered once the
+                // destructor unblocks it and kill the process after all.
+                signalfd_siginfo info;
+                while (read(signalFd, &info, sizeof(info)) > 0) {}
+                stopping = true;
+            } else {
+                auto it = connections.find(id);
+                if (it == connections.end()) continue;  // closed earlier in this batch
+                Connection& connection = it->second;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    close(id);
+                    continue;
+                }
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP)) readFrom(id, connection);
+                else if (events[i].events & EPOLLOUT) flush(id, connection);
+            }
+        }
+    }
+    shutdown();
+    return true;
+#else
+    errors += "--serve needs Linux (epoll)\n";
+    return false;
+#endif
+}
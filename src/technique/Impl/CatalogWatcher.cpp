@@ -0,0 +1,139 @@
+#include "../Header/CatalogWatcher.h"
+#include "../Header/ShardLoader.h"
+#include <cerrno>
+#include <filesystem>
+#ifdef __linux__
+#include <fnmatch.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Editors often write a file in several steps; wait for this much quiet
+    // before re-reading it.
+    constexpr int DEBOUNCE_MS = 150;
+}
+
+CatalogWatcher::CatalogWatcher(TechniqueManager& manager, std::string path)
+    : manager(manager), path(std::move(path)), sharded(ShardLoader::isShardSet(this->path)) {
+    std::error_code ec;
+    std::filesystem::path file(this->path);
+    if (sharded && std::filesystem::is_directory(file, ec)) {
+        directory = this->path;
+        namePattern = "*.json";
+    } else {
+        directory = file.has_parent_path() ? file.parent_path().string() : ".";
+        namePattern = file.filename().string();
+    }
+}
+
+CatalogWatcher::~CatalogWatcher() {
+    stop();
+}
+
+bool CatalogWatcher::start() {
+#ifdef __linux__
+    if (thread.joinable()) return true;
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || stopFd < 0 ||
+        inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        stop();
+        return false;
+    }
+    thread = std::thread(&CatalogWatcher::loop, this);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CatalogWatcher::stop() {
+#ifdef __linux__
+    if (thread.joinable()) {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(stopFd, &one, sizeof(one));
+        thread.join();
+    }
+    if (inotifyFd >= 0) ::close(inotifyFd);
+    if (stopFd >= 0) ::close(stopFd);
+    inotifyFd = stopFd = -1;
+#endif
+}
+
+bool CatalogWatcher::drainEvents() {
+    bool relevant = false;
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && fnmatch(namePattern.c_str(), event->name, 0) == 0) relevant = true;
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+#endif
+    return relevant;
+}
+
+void CatalogWatcher::loop() {
+#ifdef __linux__
+    if (!sharded) {
+        // Inotify is already armed, so an edit made while this runs is still reloaded.
+        auto live = std::make_unique<LiveCatalog>();
+        if (live->load(path)) baseline = std::move(live);
+    }
+    pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+    bool dirty = false;
+    while (true) {
+        int ready = poll(fds, 2, dirty ? DEBOUNCE_MS : -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (fds[1].revents & POLLIN) return;
+        if (ready == 0) {
+            // Quiet period after a change: publish the new snapshot.
+            dirty = false;
+            if (reload()) ++reloads;
+            else ++failures;
+            continue;
+        }
+        if ((fds[0].revents & POLLIN) && drainEvents()) dirty = true;
+    }
+#endif
+}
+
+bool CatalogWatcher::reload() {
+    bool ok;
+    std::string problems;
+    if (!sharded) {
+        ok = manager.reloadFromJson(path, nullptr, baseline.get());
+        if (ok) baseline.reset();
+        else problems = path + ": not a complete catalog file\n";
+    } else {
+        ShardLoadReport report;
+        ok = manager.loadFromShards(path, report);
+        problems = std::move(report.errors);
+    }
+    std::lock_guard<std::mutex> lock(errorMutex);
+    errors = std::move(problems);
+    return ok;
+}
+
+size_t CatalogWatcher::reloadCount() const {
+    return reloads.load();
+}
+
+size_t CatalogWatcher::failureCount() const {
+    return failures.load();
+}
+
+std::string CatalogWatcher::lastErrors() const {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    return errors;
+}
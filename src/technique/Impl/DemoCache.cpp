@@ -0,0 +1,176 @@
+#include "../Header/DemoCache.h"
+#include "Hash.h"
+#include "Process.h"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+DemoCache::DemoCache(fs::path directory, uintmax_t maxBytes)
+    : directory(std::move(directory)), maxBytes(maxBytes) {
+    std::error_code ec;
+    fs::create_directories(this->directory, ec);
+}
+
+fs::path DemoCache::defaultDirectory() {
+    if (const char* dir = std::getenv("CMT_DEMO_CACHE_DIR")) return dir;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        return fs::path(xdg) / "cpp_modern_techniques" / "demos";
+    }
+    if (const char* home = std::getenv("HOME")) {
+        return fs::path(home) / ".cache" / "cpp_modern_techniques" / "demos";
+    }
+    return fs::temp_directory_path() / "cpp_modern_techniques_demos";
+}
+
+uintmax_t DemoCache::defaultMaxBytes() {
+    if (const char* mb = std::getenv("CMT_DEMO_CACHE_MAX_MB")) {
+        char* end = nullptr;
+        unsigned long long value = std::strtoull(mb, &end, 10);
+        if (end != mb) return value * 1024 * 1024;
+    }
+    return DEFAULT_MAX_BYTES;
+}
+
+std::string DemoCache::compilerIdentity(const std::string& compiler) {
+    // Spawning "g++ --version" costs a few ms; do it once per compiler.
+    static std::mutex mutex;
+    static std::map<std::string, std::string> identities;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = identities.find(compiler);
+    if (it != identities.end()) return it->second;
+    std::string path = Process::findExecutable(compiler);
+    std::error_code ec;
+    fs::path real = fs::canonical(path, ec);
+    if (!ec) path = real.string();
+    ProcessOptions options;
+    options.timeoutSeconds = 10.0;
+    std::string identity = path + "\n" + Process::run({path, "--version"}, options).out;
+    identities.emplace(compiler, identity);
+    return identity;
+}
+
+std::string DemoCache::key(const std::string& code, const std::string& stdFlag, const std::string& compiler) const {
+    // A collision would run another demo's binary, so the key is a
+    // cryptographic digest. Length prefixes keep the pieces unambiguous.
+    std::string identity = compilerIdentity(compiler);
+    Hash::Sha256 digest;
+    for (std::string_view piece : {std::string_view(code), std::string_view(stdFlag), std::string_view(identity)}) {
+        digest.update(std::to_string(piece.size()) + ":").update(piece);
+    }
+    return digest.hex();
+}
+
+fs::path DemoCache::entryPath(const std::string& key) const {
+    return directory / (key + ".out");
+}
+
+bool DemoCache::fetch(const std::string& key, const fs::path& destination) {
+    fs::path path = entryPath(key);
+    std::error_code ec;
+    // Hard-link the entry so a concurrent eviction cannot pull it away mid-run.
+    fs::create_hard_link(path, destination, ec);
+    if (ec) {
+        ec.clear();
+        fs::copy_file(path, destination, fs::copy_options::overwrite_existing, ec);
+    }
+    if (ec) {
+        ++missCount;
+        return false;
+    }
+    // The modification time doubles as the LRU timestamp.
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    ++hitCount;
+    return true;
+}
+
+bool DemoCache::store(const std::string& key, const fs::path& binary) {
+    fs::path target = entryPath(key);
+    fs::path staging = directory / (key + STAGING_MARKER + std::to_string(getpid()) + "." +
+                                    std::to_string(std::hash<std::string>{}(binary.string())));
+    std::error_code ec;
+    fs::copy_file(binary, staging, fs::copy_options::overwrite_existing, ec);
+    if (ec) {
+        fs::remove(staging, ec);
+        return false;
+    }
+    uintmax_t added = fs::file_size(staging, ec);
+    if (ec) added = 0;
+    uintmax_t replaced = fs::file_size(target, ec);
+    if (ec) replaced = 0;
+    // rename() is atomic, so concurrent sessions never see a half-written binary.
+    fs::rename(staging, target, ec);
+    if (ec) {
+        fs::remove(staging, ec);
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(evictMutex);
+        if (knownBytes) *knownBytes = *knownBytes - std::min(*knownBytes, replaced) + added;
+    }
+    evict();
+    return true;
+}
+
+void DemoCache::evict() {
+    std::lock_guard<std::mutex> lock(evictMutex);
+    // The running total is kept up to date by store(); the directory is only
+    // scanned on first use and when the total says the cap was crossed (other
+    // sessions add entries this one does not see).
+    if (knownBytes && *knownBytes <= maxBytes) return;
+    struct Entry {
+        fs::path path;
+        uintmax_t size;
+        fs::file_time_type used;
+    };
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+    auto now = fs::file_time_type::clock::now();
+    std::error_code ec;
+    for (const auto& item : fs::directory_iterator(directory, ec)) {
+        std::error_code itemEc;
+        auto used = item.last_write_time(itemEc);
+        if (itemEc) continue;
+        if (item.path().filename().string().find(STAGING_MARKER) != std::string::npos) {
+            // Left behind by a session that died between copy and rename.
+            if (now - used > STALE_STAGING_AGE) fs::remove(item.path(), itemEc);
+            continue;
+        }
+        if (item.path().extension() != ".out") continue;
+        uintmax_t size = item.file_size(itemEc);
+        if (itemEc) continue;
+        entries.push_back({item.path(), size, used});
+        total += size;
+    }
+    if (total > maxBytes) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.used < b.used; });
+        for (const auto& entry : entries) {
+            if (total <= maxBytes) break;
+            if (fs::remove(entry.path, ec)) {
+                total -= entry.size;
+                ++evictionCount;
+            }
+        }
+    }
+    knownBytes = total;
+}
+
+const fs::path& DemoCache::getDirectory() const {
+    return directory;
+}
+
+size_t DemoCache::hits() const {
+    return hitCount.load();
+}
+
+size_t DemoCache::misses() const {
+    return missCount.load();
+}
+
+size_t DemoCache::evictions() const {
+    return evictionCount.load();
+}
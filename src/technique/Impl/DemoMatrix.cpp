@@ -0,0 +1,112 @@
+#include "../Header/DemoMatrix.h"
+#include "../Header/DemoRunner.h"
+#include "../Header/DemoVerifier.h"
+#include "Process.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <iomanip>
+
+DemoMatrix::DemoMatrix(const TechniqueManager& manager, std::vector<std::string> compilers,
+                       std::vector<std::string> optFlags, size_t threads)
+    : manager(manager), compilers(std::move(compilers)), optFlags(std::move(optFlags)), threads(threads) {}
+
+std::vector<std::string> DemoMatrix::availableCompilers() {
+    std::vector<std::string> found;
+    for (const char* compiler : {"g++", "clang++"}) {
+        if (!Process::findExecutable(compiler).empty()) found.push_back(compiler);
+    }
+    return found;
+}
+
+std::vector<MatrixRow> DemoMatrix::run() const {
+    auto catalog = manager.getCatalog();
+    std::vector<MatrixRow> rows(catalog ? catalog->size() : 0);
+    ThreadPool pool(threads);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const Technique& tech = catalog->technique(i);
+        rows[i].name = tech.getName();
+        for (const auto& compiler : compilers) {
+            for (const char* standard : STANDARDS) {
+                for (const auto& optFlag : optFlags) {
+                    MatrixCell cell;
+                    cell.compiler = compiler;
+                    cell.standard = standard;
+                    cell.optFlag = optFlag;
+                    rows[i].cells.push_back(std::move(cell));
+                }
+            }
+        }
+        // Cells are filled in place; the vector is not resized after this point.
+        for (MatrixCell& cell : rows[i].cells) {
+            pool.submit([&tech, &cell] {
+                if (tech.getDemoCode().empty()) {
+                    cell.failure = "no demo code";
+                    return;
+                }
+                DemoRunner runner(nullptr, nullptr, cell.compiler);
+                DemoResult demo = runner.compileAndRun(tech.getDemoCode(), "-std=" + cell.standard, cell.optFlag);
+                cell.compileSeconds = demo.compileSeconds;
+                cell.compilerMaxRssKb = demo.compilerMaxRssKb;
+                cell.binaryBytes = demo.binaryBytes;
+                if (!demo.compiled) {
+                    cell.failure = "compile";
+                } else if (demo.timedOut || demo.termSignal != 0 || demo.exitCode != 0) {
+                    cell.failure = "run";
+                } else {
+                    std::string mismatch;
+                    cell.passed = DemoVerifier::outputsMatch(demo.output, tech.getExpectedOutput(), mismatch);
+                    if (!cell.passed) cell.failure = "output";
+                }
+            });
+        }
+    }
+    pool.waitIdle();
+    return rows;
+}
+
+std::string DemoMatrix::minimumStandard(const MatrixRow& row, const std::string& compiler) {
+    for (const char* standard : STANDARDS) {
+        for (const auto& cell : row.cells) {
+            if (cell.compiler == compiler && cell.standard == standard && cell.passed) return standard;
+        }
+    }
+    return {};
+}
+
+int DemoMatrix::report(const std::vector<MatrixRow>& rows, double totalSeconds, std::ostream& out) {
+    size_t cells = 0;
+    size_t passed = 0;
+    std::vector<std::string> compilers;
+    for (const auto& row : rows) {
+        for (const auto& cell : row.cells) {
+            if (std::find(compilers.begin(), compilers.end(), cell.compiler) == compilers.end()) {
+                compilers.push_back(cell.compiler);
+            }
+        }
+    }
+    out << std::fixed;
+    for (const auto& row : rows) {
+        out << row.name << "  -  minimum standard:";
+        for (const auto& compiler : compilers) {
+            std::string minimum = minimumStandard(row, compiler);
+            out << " " << compiler << " " << (minimum.empty() ? "none" : minimum);
+        }
+        out << "\n";
+        out << "  " << std::left << std::setw(9) << "compiler" << std::setw(7) << "std" << std::setw(5) << "opt"
+            << std::setw(16) << "result" << std::right << std::setw(11) << "compile s"
+            << std::setw(12) << "cc mem MB" << std::setw(12) << "binary KB" << "\n";
+        for (const auto& cell : row.cells) {
+            ++cells;
+            if (cell.passed) ++passed;
+            out << "  " << std::left << std::setw(9) << cell.compiler << std::setw(7) << cell.standard
+                << std::setw(5) << cell.optFlag
+                << std::setw(16) << (cell.passed ? "PASS" : "FAIL (" + cell.failure + ")") << std::right
+                << std::setprecision(2) << std::setw(11) << cell.compileSeconds
+                << std::setprecision(1) << std::setw(12) << cell.compilerMaxRssKb / 1024.0
+                << std::setw(12) << cell.binaryBytes / 1024.0 << "\n";
+        }
+        out << "\n";
+    }
+    out << passed << "/" << cells << " cells passed in " << std::setprecision(2) << totalSeconds << "s\n";
+    return passed == cells ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include "../Header/DemoPrelude.h"
+#include "../Header/DemoCache.h"
+#include "../Header/TechniqueParser.h"
+#include "Hash.h"
+#include "Process.h"
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char* const STD_LEVELS[] = {"-std=c++17", "-std=c++20", "-std=c++23"};
+
+    const char* const CPP17_HEADERS[] = {
+        "algorithm", "any", "array", "cmath", "functional", "iostream", "map", "memory",
+        "numeric", "optional", "set", "sstream", "stdexcept", "string", "string_view",
+        "tuple", "type_traits", "unordered_map", "utility", "variant", "vector"
+    };
+    const char* const CPP20_HEADERS[] = {"compare", "concepts", "coroutine", "ranges", "span", "format"};
+    const char* const CPP23_HEADERS[] = {"expected", "print", "mdspan"};
+
+    template <size_t N>
+    void appendIncludes(std::string& text, const char* const (&headers)[N]) {
+        for (const char* header : headers) {
+            // __has_include keeps the prelude valid on standard libraries that
+            // have not shipped every header yet.
+            text += std::string("#if __has_include(<") + header + ">)\n#include <" + header + ">\n#endif\n";
+        }
+    }
+}
+
+DemoPrelude::DemoPrelude(fs::path directory, std::string compiler)
+    : directory(std::move(directory)), compiler(std::move(compiler)) {}
+
+fs::path DemoPrelude::defaultDirectory() {
+    return DemoCache::defaultDirectory().parent_path() / "pch";
+}
+
+std::string DemoPrelude::headerText(const std::string& stdFlag) {
+    std::string text = "#pragma once\n";
+    appendIncludes(text, CPP17_HEADERS);
+    size_t level = stdFlag.find("++");
+    int year = level == std::string::npos ? 0 : TechniqueParser::standardYear(std::string_view(stdFlag).substr(level + 2));
+    if (year >= 2020) appendIncludes(text, CPP20_HEADERS);
+    if (year >= 2023) appendIncludes(text, CPP23_HEADERS);
+    return text;
+}
+
+fs::path DemoPrelude::ensureBuilt(const std::string& stdFlag) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = built.find(stdFlag);
+    if (it != built.end()) return it->second;
+
+    // A compiler upgrade or a change to the header list must not reuse an
+    // old PCH, so both are part of the directory name.
+    std::string level = stdFlag.substr(stdFlag.find('=') + 1);
+    std::string text = headerText(stdFlag);
+    uint64_t key = Hash::fnv1a64(text, Hash::fnv1a64(DemoCache::compilerIdentity(compiler)));
+    fs::path dir = directory / Hash::toHex(key) / level;
+    fs::path header = dir / "prelude.h";
+    fs::path pch = dir / "prelude.h.gch";
+    std::error_code ec;
+    if (!fs::is_regular_file(pch, ec) || !fs::is_regular_file(header, ec)) {
+        fs::create_directories(dir, ec);
+        std::string suffix = ".tmp." + std::to_string(getpid());
+        fs::path tmpHeader = dir / ("prelude.h" + suffix);
+        {
+            std::ofstream out(tmpHeader);
+            out << text;
+        }
+        fs::rename(tmpHeader, header, ec);
+        fs::path tmpPch = dir / ("prelude.h.gch" + suffix);
+        ProcessOptions options;
+        options.timeoutSeconds = 300.0;
+        if (ec || !Process::run({compiler, stdFlag, "-x", "c++-header", header.string(),
+                                 "-o", tmpPch.string()}, options).succeeded()) {
+            fs::remove(tmpPch, ec);
+            built[stdFlag] = fs::path();
+            return {};
+        }
+        fs::rename(tmpPch, pch, ec);
+        if (ec) {
+            fs::remove(tmpPch, ec);
+            built[stdFlag] = fs::path();
+            return {};
+        }
+    }
+    built[stdFlag] = header;
+    return header;
+}
+
+bool DemoPrelude::buildAll(std::string& errors) {
+    bool ok = true;
+    for (const char* level : STD_LEVELS) {
+        if (ensureBuilt(level).empty()) {
+            errors += std::string("failed to precompile prelude for ") + level + "\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
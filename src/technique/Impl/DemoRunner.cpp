@@ -0,0 +1,154 @@
+#include "../Header/DemoRunner.h"
+#include "Process.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+namespace {
+    // A runaway compile or demo must not hang the session.
+    ProcessOptions compileLimits() {
+        ProcessOptions options;
+        options.timeoutSeconds = 120.0;
+        options.cpuSeconds = 120;
+        options.memoryBytes = 4ULL * 1024 * 1024 * 1024;
+        return options;
+    }
+
+    ProcessOptions runLimits() {
+        ProcessOptions options;
+        options.timeoutSeconds = 10.0;
+        options.cpuSeconds = 5;
+        options.memoryBytes = 1ULL * 1024 * 1024 * 1024;
+        return options;
+    }
+
+    std::filesystem::path makeWorkDir() {
+        std::string pattern = (std::filesystem::temp_directory_path() / "cmt_demo_XXXXXX").string();
+        if (mkdtemp(pattern.data()) == nullptr) return {};
+        return pattern;
+    }
+}
+
+DemoRunner::DemoRunner(DemoCache* cache, DemoPrelude* prelude, std::string compiler)
+    : cache(cache), prelude(prelude), compiler(std::move(compiler)) {}
+
+DemoResult DemoRunner::compileAndRun(const std::string& code) const {
+    return compileAndRun(code, DEFAULT_STD_FLAG, "");
+}
+
+DemoResult DemoRunner::compileAndRun(const std::string& code, const std::string& std_flag,
+                                     const std::string& optFlag) const {
+    TraceSpan span("demo.compileAndRun");
+    DemoResult result;
+    std::filesystem::path dir = makeWorkDir();
+    if (dir.empty()) {
+        result.compileErrors = "cannot create temporary directory";
+        return result;
+    }
+    std::filesystem::path binary = dir / "demo.out";
+    std::string key;
+    if (cache) {
+        TraceSpan lookup("demo.cacheLookup");
+        // Binaries built against the prelude are kept apart, so a runner without
+        // one (--verify-all) only ever reuses plain compiles of the code as shown.
+        std::string flags = optFlag.empty() ? std_flag : std_flag + " " + optFlag;
+        if (prelude && optFlag.empty()) flags += " +prelude";
+        key = cache->key(code, flags, compiler);
+        result.cacheHit = result.compiled = cache->fetch(key, binary);
+        Trace::counter("demo.cacheHit", result.cacheHit);
+    }
+
+    if (!result.cacheHit) {
+        ProcessOptions options = compileLimits();
+        options.input = code;
+        std::vector<std::string> args = {compiler, std_flag, "-x", "c++", "-", "-o", binary.string()};
+        if (!optFlag.empty()) args.insert(args.begin() + 2, optFlag);
+        // The prelude PCH is built without optimization flags and would be rejected.
+        std::filesystem::path header;
+        if (prelude && optFlag.empty()) {
+            TraceSpan ensure("demo.preludeEnsureBuilt");
+            header = prelude->ensureBuilt(std_flag);
+        }
+        ProcessResult compile;
+        if (!header.empty()) {
+            TraceSpan pch("demo.compileWithPch");
+            std::vector<std::string> pchArgs = args;
+            pchArgs.insert(pchArgs.begin() + 1, {"-include", header.string()});
+            compile = Process::run(pchArgs, options);
+            result.usedPch = result.compiled = compile.succeeded();
+            result.compileSeconds += compile.wallSeconds;
+            result.compilerMaxRssKb = compile.maxRssKb;
+        }
+        if (!result.compiled) {
+            TraceSpan plain("demo.compile");
+            compile = Process::run(args, options);
+            result.compiled = compile.succeeded();
+            result.compileSeconds += compile.wallSeconds;
+            result.compilerMaxRssKb = std::max(result.compilerMaxRssKb, compile.maxRssKb);
+        }
+        if (!result.compiled) {
+            result.compileErrors = compile.timedOut ? "compilation timed out\n" : compile.err;
+        } else if (cache) {
+            cache->store(key, binary);
+        }
+    }
+
+    if (result.compiled) {
+        std::error_code sizeError;
+        uintmax_t size = std::filesystem::file_size(binary, sizeError);
+        if (!sizeError) result.binaryBytes = size;
+        TraceSpan runSpan("demo.run");
+        ProcessResult run = Process::run({binary.string()}, runLimits());
+        result.output = std::move(run.out);
+        result.errorOutput = std::move(run.err);
+        if (run.truncated) result.errorOutput += "\n[output limit exceeded; demo killed]\n";
+        result.exitCode = run.exitCode;
+        result.termSignal = run.termSignal;
+        result.timedOut = run.timedOut;
+        result.runSeconds = run.wallSeconds;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    return result;
+}
+
+DemoProfile DemoRunner::profile(const std::string& code, const std::string& optFlag, size_t runs) const {
+    TraceSpan span("demo.profile");
+    DemoProfile profile;
+    profile.optFlag = optFlag;
+    std::filesystem::path dir = makeWorkDir();
+    if (dir.empty()) {
+        profile.compileErrors = "cannot create temporary directory";
+        return profile;
+    }
+    std::filesystem::path binary = dir / "demo.out";
+    ProcessOptions options = compileLimits();
+    options.input = code;
+    ProcessResult compile = Process::run(
+        {compiler, DEFAULT_STD_FLAG, optFlag, "-x", "c++", "-", "-o", binary.string()}, options);
+    profile.compiled = compile.succeeded();
+    profile.compileSeconds = compile.wallSeconds;
+    if (!profile.compiled) {
+        profile.compileErrors = compile.timedOut ? "compilation timed out\n" : compile.err;
+    }
+
+    ProcessOptions limits = runLimits();
+    limits.hardwareCounters = true;
+    for (size_t i = 0; profile.compiled && i < runs; ++i) {
+        ProcessResult run = Process::run({binary.string()}, limits);
+        if (!run.succeeded()) {
+            profile.runError = run.timedOut ? "time limit exceeded"
+                : run.termSignal ? "killed by signal " + std::to_string(run.termSignal)
+                : "exit code " + std::to_string(run.exitCode);
+            break;
+        }
+        profile.samples.push_back({run.wallSeconds, run.userSeconds, run.systemSeconds, run.maxRssKb, run.counters});
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    return profile;
+}
@@ -0,0 +1,89 @@
+#include "../Header/DemoVerifier.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    // Trailing spaces and blank lines are not significant for comparison.
+    std::vector<std::string> normalizedLines(const std::string& text) {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            size_t end = line.find_last_not_of(" \t\r");
+            lines.push_back(end == std::string::npos ? "" : line.substr(0, end + 1));
+        }
+        while (!lines.empty() && lines.back().empty()) lines.pop_back();
+        return lines;
+    }
+}
+
+DemoVerifier::DemoVerifier(const TechniqueManager& manager, DemoCache* cache, size_t threads)
+    : manager(manager), cache(cache), threads(threads) {}
+
+bool DemoVerifier::outputsMatch(const std::string& actual, const std::string& expected, std::string& mismatch) {
+    auto got = normalizedLines(actual);
+    auto want = normalizedLines(expected);
+    for (size_t i = 0; i < std::max(got.size(), want.size()); ++i) {
+        const std::string& g = i < got.size() ? got[i] : std::string("<missing>");
+        const std::string& w = i < want.size() ? want[i] : std::string("<missing>");
+        if (g != w) {
+            mismatch = "line " + std::to_string(i + 1) + ": expected \"" + w + "\", got \"" + g + "\"";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<VerifyResult> DemoVerifier::run() const {
+    // One snapshot for the whole run: a hot reload must not change the size
+    // or free the techniques under the workers.
+    auto catalog = manager.getCatalog();
+    std::vector<VerifyResult> results(catalog ? catalog->size() : 0);
+    DemoRunner runner(cache);
+    ThreadPool pool(threads);
+    for (size_t i = 0; i < results.size(); ++i) {
+        pool.submit([&, i] {
+            const Technique& tech = catalog->technique(i);
+            VerifyResult& result = results[i];
+            result.name = tech.getName();
+            if (tech.getDemoCode().empty()) {
+                result.mismatch = "no demo code";
+                return;
+            }
+            result.demo = runner.compileAndRun(tech.getDemoCode());
+            if (!result.demo.compiled) {
+                result.mismatch = "compilation failed";
+            } else if (result.demo.timedOut) {
+                result.mismatch = "timed out";
+            } else if (result.demo.termSignal != 0) {
+                result.mismatch = "killed by signal " + std::to_string(result.demo.termSignal);
+            } else if (result.demo.exitCode != 0) {
+                result.mismatch = "exit code " + std::to_string(result.demo.exitCode);
+            } else {
+                result.passed = outputsMatch(result.demo.output, tech.getExpectedOutput(), result.mismatch);
+            }
+        });
+    }
+    pool.waitIdle();
+    return results;
+}
+
+int DemoVerifier::report(const std::vector<VerifyResult>& results, double totalSeconds, std::ostream& out) {
+    size_t passed = 0;
+    for (const auto& r : results) {
+        double seconds = r.demo.compileSeconds + r.demo.runSeconds;
+        out << (r.passed ? "[PASS] " : "[FAIL] ") << r.name
+            << " (" << std::fixed << std::setprecision(2) << seconds << "s"
+            << (r.demo.cacheHit ? ", cached" : "") << ")";
+        if (!r.passed) out << " - " << r.mismatch;
+        out << "\n";
+        if (r.passed) ++passed;
+    }
+    out << "\n" << passed << "/" << results.size() << " passed, "
+        << (results.size() - passed) << " failed in "
+        << std::fixed << std::setprecision(2) << totalSeconds << "s\n";
+    return passed == results.size() ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include "../Header/DetailPage.h"
+#include "Ansi.h"
+#include "TerminalFrame.h"
+#include "Trace.h"
+#include <string_view>
+#include <unordered_set>
+
+using namespace ansi;
+
+namespace {
+    template <typename... Parts>
+    std::string concat(const Parts&... parts) {
+        std::string line;
+        line.reserve((std::string_view(parts).size() + ...));
+        (line.append(parts), ...);
+        return line;
+    }
+
+    // Title and text on one line, or the title alone with the text indented
+    // below it when the text spans several lines (e.g. object-typed syntax).
+    void addField(std::vector<std::string>& lines, const char* color, const char* title, std::string_view text) {
+        if (text.find('\n') == std::string_view::npos) {
+            lines.push_back(concat(BOLD, color, title, " ", RESET, text));
+            return;
+        }
+        lines.push_back(concat(BOLD, color, title, RESET));
+        TerminalFrame::forEachLine(text, [&](std::string_view line) {
+            lines.push_back(concat("   ", RESET, line));
+        });
+    }
+
+    void addList(std::vector<std::string>& lines, const char* color, const char* title,
+                 const std::vector<std::string>& items) {
+        if (items.empty()) return;
+        lines.push_back(concat(BOLD, color, title, RESET));
+        for (const auto& item : items) lines.push_back(concat("  - ", RESET, item));
+    }
+}
+
+std::vector<std::string> DetailPage::render(const Technique& tech) {
+    TraceSpan span("menu.renderDetailPage");
+    std::vector<std::string> lines;
+    lines.push_back(concat(BOLD, UNDERLINE, YELLOW, "  ", tech.getName(), RESET,
+                           "  (", GREEN, tech.getCppVersion(), RESET, ")"));
+    addField(lines, MAGENTA, " Definition:", tech.getDefinition());
+    addList(lines, BLUE, " Use Cases:", tech.getUseCases());
+    addField(lines, YELLOW, " Syntax:", tech.getSyntax());
+
+    lines.push_back(concat(BOLD, UNDERLINE, RED, " Code Demo:", RESET));
+    TerminalFrame::forEachLine(tech.getDemoCode(), [&](std::string_view line) {
+        lines.push_back(concat("  ", RESET, line));
+    });
+    if (!tech.getExpectedOutput().empty()) {
+        lines.push_back(concat(BOLD, GREEN, " Expected Output:", RESET));
+        TerminalFrame::forEachLine(tech.getExpectedOutput(), [&](std::string_view line) {
+            lines.push_back(concat("  ", RESET, GREEN, line, RESET));
+        });
+    }
+    addList(lines, MAGENTA, " Best Practices:", tech.getBestPractices());
+    addList(lines, YELLOW, " Advantages:", tech.getAdvantages());
+    TerminalFrame::forEachLine(tech.getNotes(), [&](std::string_view line) {
+        lines.push_back(concat(BOLD, BLUE, " Note: ", RESET, line));
+    });
+    TerminalFrame::forEachLine(tech.getDemoNote(), [&](std::string_view line) {
+        lines.push_back(concat(BOLD, UNDERLINE, RED, " [Demo Note] ", RESET, line));
+    });
+    return lines;
+}
+
+const std::vector<std::string>& DetailPageCache::get(const Technique& tech) {
+    auto it = pages.find(&tech);
+    if (it == pages.end()) it = pages.emplace(&tech, DetailPage::render(tech)).first;
+    return it->second;
+}
+
+void DetailPageCache::retain(const ICatalog& catalog) {
+    std::unordered_set<const Technique*> live;
+    for (size_t i = 0; i < catalog.size(); ++i) live.insert(&catalog.technique(i));
+    std::erase_if(pages, [&](const auto& page) { return !live.contains(page.first); });
+}
+
+void DetailPageCache::clear() {
+    pages.clear();
+}
+
+size_t DetailPageCache::size() const {
+    return pages.size();
+}
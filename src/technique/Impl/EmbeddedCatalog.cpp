@@ -0,0 +1,54 @@
+#include "../Header/EmbeddedCatalog.h"
+#include "EmbeddedCatalogData.h"
+#include <string>
+
+namespace {
+    std::vector<std::string> toVector(std::span<const std::string_view> items) {
+        return std::vector<std::string>(items.begin(), items.end());
+    }
+}
+
+std::span<const EmbeddedFeature> EmbeddedCatalog::features() {
+    return embedded_catalog::features;
+}
+
+const EmbeddedCatalog& EmbeddedCatalog::instance() {
+    static const EmbeddedCatalog catalog;
+    return catalog;
+}
+
+size_t EmbeddedCatalog::size() const {
+    return features().size();
+}
+
+std::string_view EmbeddedCatalog::name(size_t index) const {
+    return features()[index].name;
+}
+
+std::string_view EmbeddedCatalog::cppVersion(size_t index) const {
+    return features()[index].cpp_version;
+}
+
+const Technique& EmbeddedCatalog::technique(size_t index) const {
+    std::lock_guard<std::mutex> lock(materializeMutex);
+    if (materialized.empty()) materialized.resize(size());
+    if (!materialized[index]) {
+        const EmbeddedFeature& f = features()[index];
+        materialized[index] = std::make_unique<Technique>(
+            std::string(f.name), std::string(f.definition), std::string(f.usage), std::string(f.syntax),
+            std::string(f.demo_code), std::string(f.cpp_version), std::string(f.notes), std::string(),
+            toVector(f.use_cases), toVector(f.best_practices), toVector(f.advantages),
+            std::string(f.expected_output));
+    }
+    return *materialized[index];
+}
+
+void EmbeddedCatalog::visitText(size_t index, const TextVisitor& visit) const {
+    const EmbeddedFeature& f = features()[index];
+    visit(TextField::Name, f.name);
+    visit(TextField::Definition, f.definition);
+    for (std::string_view text : f.use_cases) visit(TextField::UseCase, text);
+    for (std::string_view text : f.best_practices) visit(TextField::BestPractice, text);
+    for (std::string_view text : f.advantages) visit(TextField::Advantage, text);
+    visit(TextField::DemoCode, f.demo_code);
+}
@@ -0,0 +1,224 @@
+#include "../Header/LazyJsonCatalog.h"
+#include "../Header/TechniqueParser.h"
+#include <algorithm>
+#include <iterator>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+    // Input iterator over the mapped bytes that publishes how far the parser
+    // has read, so the SAX handler can turn events into byte offsets.
+    class TrackingIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        TrackingIterator(const char* pos, const char** cursor) : pos(pos), cursor(cursor) {}
+        reference operator*() const { return *pos; }
+        TrackingIterator& operator++() {
+            *cursor = ++pos;
+            return *this;
+        }
+        TrackingIterator operator++(int) {
+            TrackingIterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const TrackingIterator& other) const { return pos == other.pos; }
+        bool operator!=(const TrackingIterator& other) const { return pos != other.pos; }
+    private:
+        const char* pos;
+        const char** cursor;
+    };
+
+    enum class Role { Other, Root, FeaturesRoot, Section, FeatureList, Feature };
+
+    struct Frame {
+        Role role;
+        std::string key;
+    };
+
+    struct Section {
+        std::string key;
+        std::string version;
+    };
+
+    struct FeatureIndexer : nlohmann::json_sax<json> {
+        const char* base;
+        const char* const* cursor;
+        std::vector<Frame> stack;
+        std::vector<Section> sections;
+        std::vector<std::string> names;
+        std::vector<size_t> owners;  // section of each feature
+        std::vector<std::pair<size_t, size_t>> ranges;
+        bool sawRoot = false;
+
+        FeatureIndexer(const char* base, const char* const* cursor) : base(base), cursor(cursor) {}
+
+        size_t consumed() const { return static_cast<size_t>(*cursor - base); }
+
+        Role childRole(bool isObject) {
+            if (stack.empty()) return isObject ? Role::Root : Role::Other;
+            const Frame& parent = stack.back();
+            switch (parent.role) {
+            case Role::Root:
+                if (isObject && parent.key == "cpp_modern_features") {
+                    sawRoot = true;
+                    return Role::FeaturesRoot;
+                }
+                return Role::Other;
+            case Role::FeaturesRoot:
+                // Any object may be a version section; it only contributes
+                // features if it has a "features" array.
+                if (!isObject) return Role::Other;
+                sections.push_back({parent.key, ""});
+                return Role::Section;
+            case Role::Section:
+                return (!isObject && parent.key == "features") ? Role::FeatureList : Role::Other;
+            case Role::FeatureList:
+                return isObject ? Role::Feature : Role::Other;
+            default:
+                return Role::Other;
+            }
+        }
+
+        bool start_object(std::size_t) override {
+            Role role = childRole(true);
+            if (role == Role::Feature) {
+                names.emplace_back();
+                owners.push_back(sections.size() - 1);
+                ranges.emplace_back(consumed() - 1, 0);  // '{' was just read
+            }
+            stack.push_back({role, {}});
+            return true;
+        }
+        bool end_object() override {
+            if (stack.back().role == Role::Feature) ranges.back().second = consumed();
+            stack.pop_back();
+            return true;
+        }
+        bool start_array(std::size_t) override {
+            stack.push_back({childRole(false), {}});
+            return true;
+        }
+        bool end_array() override {
+            stack.pop_back();
+            return true;
+        }
+        bool key(string_t& val) override {
+            stack.back().key = val;
+            return true;
+        }
+        bool string(string_t& val) override {
+            const Frame& top = stack.back();
+            if (top.role == Role::Section && top.key == "version") {
+                sections.back().version = val;
+            } else if (top.role == Role::Feature && top.key == "name") {
+                names.back() = val;
+            }
+            return true;
+        }
+        bool null() override { return true; }
+        bool boolean(bool) override { return true; }
+        bool number_integer(number_integer_t) override { return true; }
+        bool number_unsigned(number_unsigned_t) override { return true; }
+        bool number_float(number_float_t, const string_t&) override { return true; }
+        bool binary(binary_t&) override { return true; }
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+            return false;
+        }
+    };
+}
+
+bool LazyJsonCatalog::open(const std::string& filename) {
+    MappedFile mapped;
+    if (!mapped.open(filename)) return false;
+    const char* base = mapped.begin();
+    const char* cursor = base;
+    FeatureIndexer indexer(base, &cursor);
+    bool ok = json::sax_parse(TrackingIterator(base, &cursor), TrackingIterator(base + mapped.size(), &cursor),
+                              &indexer, nlohmann::detail::input_format_t::json, false);
+    if (!ok || !indexer.sawRoot) return false;
+    file = std::move(mapped);
+
+    // Keep the eager loader's order: sections by standard, then file order.
+    std::vector<size_t> order(indexer.names.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return TechniqueParser::sectionBefore(indexer.sections[indexer.owners[a]].key,
+                                              indexer.sections[indexer.owners[b]].key);
+    });
+
+    sectionVersions.clear();
+    for (auto& section : indexer.sections) sectionVersions.push_back(std::move(section.version));
+    entries.clear();
+    entries.reserve(order.size());
+    for (size_t i : order) {
+        entries.push_back({std::move(indexer.names[i]), indexer.owners[i],
+                           indexer.ranges[i].first, indexer.ranges[i].second});
+    }
+    materialized.clear();
+    materialized.resize(entries.size());
+    return true;
+}
+
+size_t LazyJsonCatalog::size() const {
+    return entries.size();
+}
+
+std::string_view LazyJsonCatalog::name(size_t index) const {
+    return entries[index].name;
+}
+
+std::string_view LazyJsonCatalog::cppVersion(size_t index) const {
+    return sectionVersions[entries[index].section];
+}
+
+std::unique_ptr<Technique> LazyJsonCatalog::parse(size_t index) const {
+    const Entry& entry = entries[index];
+    const std::string& version = sectionVersions[entry.section];
+    if (!file.unchanged()) {
+        // Truncated or rewritten in place: the byte ranges no longer describe the file.
+        return std::make_unique<Technique>(entry.name, "The catalog file changed on disk after it was opened; "
+                                           "reopen it to see this feature.", "", "", "", version);
+    }
+    try {
+        json item = json::parse(file.begin() + entry.begin, file.begin() + entry.end);
+        return std::make_unique<Technique>(TechniqueParser::fromJson(item, version));
+    } catch (const json::exception& e) {
+        // A malformed member (e.g. a number where a string list belongs) only
+        // shows up here; report it on the page instead of failing the session.
+        return std::make_unique<Technique>(entry.name, std::string("Cannot load this feature: ") + e.what(),
+                                           "", "", "", version);
+    }
+}
+
+const Technique& LazyJsonCatalog::technique(size_t index) const {
+    {
+        std::lock_guard<std::mutex> lock(materializeMutex);
+        if (materialized[index]) return *materialized[index];
+    }
+    // Parse outside the lock so concurrent readers of other entries are not serialized.
+    std::unique_ptr<Technique> tech = parse(index);
+    std::lock_guard<std::mutex> lock(materializeMutex);
+    if (!materialized[index]) materialized[index] = std::move(tech);
+    return *materialized[index];
+}
+
+void LazyJsonCatalog::visitText(size_t index, const TextVisitor& visit) const {
+    const Technique* kept = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(materializeMutex);
+        kept = materialized[index].get();
+    }
+    if (kept) {
+        ICatalog::visitText(*kept, visit);
+        return;
+    }
+    // Parsed for the visit only; the record is not cached.
+    ICatalog::visitText(*parse(index), visit);
+}
@@ -0,0 +1,104 @@
+#include "../Header/LiveCatalog.h"
+#include "../Header/TechniqueParser.h"
+#include <fstream>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+bool LiveCatalog::load(const std::string& filename, const LiveCatalog* previous, CatalogDiff* diff) {
+    std::ifstream file(filename);
+    if (!file.is_open()) return false;
+    // The file may be caught half-written by an editor; that is a failed
+    // load, not an error worth throwing across the watcher thread.
+    json j = json::parse(file, nullptr, false);
+    if (j.is_discarded() || !j.contains("cpp_modern_features")) return false;
+
+    std::unordered_map<std::string_view, const Entry*> old;
+    if (previous) {
+        for (const auto& entry : previous->entries) old.try_emplace(entry.id, &entry);
+    }
+    CatalogDiff counts;
+    std::vector<Entry> loaded;
+    try {
+        const auto& features_root = j["cpp_modern_features"];
+        for (const auto& version_key : TechniqueParser::sectionKeys(features_root)) {
+            const auto& version = features_root[version_key];
+            std::string cpp_version = version.value("version", "");
+            for (const auto& item : version["features"]) {
+                Entry entry;
+                entry.id = item.value("id", item.value("name", ""));
+                entry.hash = TechniqueParser::contentHash(item, cpp_version);
+                auto it = old.find(entry.id);
+                if (it != old.end() && it->second->hash == entry.hash) {
+                    entry.technique = it->second->technique;
+                    ++counts.unchanged;
+                } else {
+                    entry.technique = std::make_shared<const Technique>(TechniqueParser::fromJson(item, cpp_version));
+                    ++(it != old.end() ? counts.changed : counts.added);
+                }
+                if (it != old.end()) old.erase(it);
+                loaded.push_back(std::move(entry));
+            }
+        }
+    } catch (const json::exception&) {
+        return false;
+    }
+    counts.removed = old.size();
+    entries = std::move(loaded);
+    if (diff) *diff = counts;
+    return true;
+}
+
+bool LiveCatalog::loadShards(const std::vector<std::string>& shards, ShardLoadReport& report,
+                             const LiveCatalog* previous, CatalogDiff* diff) {
+    std::unordered_map<std::string_view, const Entry*> old;
+    if (previous) {
+        for (const auto& entry : previous->entries) old.try_emplace(entry.id, &entry);
+    }
+    // Only read while the shards are parsed, so the loader's threads may share it.
+    auto reuse = [&](const std::string& id, uint64_t hash) -> std::shared_ptr<const Technique> {
+        auto it = old.find(id);
+        return it != old.end() && it->second->hash == hash ? it->second->technique : nullptr;
+    };
+    std::vector<ShardEntry> merged;
+    if (!ShardLoader::loadEntries(shards, merged, report, reuse)) return false;
+
+    CatalogDiff counts;
+    std::vector<Entry> loaded;
+    loaded.reserve(merged.size());
+    for (auto& feature : merged) {
+        auto it = old.find(feature.id);
+        if (it == old.end()) {
+            ++counts.added;
+        } else {
+            ++(it->second->technique == feature.technique ? counts.unchanged : counts.changed);
+            old.erase(it);
+        }
+        loaded.push_back({std::move(feature.id), feature.hash, std::move(feature.technique)});
+    }
+    counts.removed = old.size();
+    entries = std::move(loaded);
+    if (diff) *diff = counts;
+    return true;
+}
+
+size_t LiveCatalog::size() const {
+    return entries.size();
+}
+
+std::string_view LiveCatalog::name(size_t index) const {
+    return entries[index].technique->getName();
+}
+
+std::string_view LiveCatalog::cppVersion(size_t index) const {
+    return entries[index].technique->getCppVersion();
+}
+
+const Technique& LiveCatalog::technique(size_t index) const {
+    return *entries[index].technique;
+}
+
+std::string_view LiveCatalog::id(size_t index) const {
+    return entries[index].id;
+}
@@ -1,25 +1,27 @@
 #include "../Header/Menu.h"
+#include "../Header/DemoRunner.h"
+#include "../Header/LiveCatalog.h"
+#include "Ansi.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <cstdlib>
-#include <fstream>
-#include <sstream>  
-#include <string>   
-#include <filesystem>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
+using namespace ansi;
+
 namespace {
-    
-    const char* CYAN = "\033[36m";
-    const char* YELLOW = "\033[33m";
-    const char* GREEN = "\033[32m";
-    const char* RED = "\033[31m";
-    const char* RESET = "\033[0m";
-    const char* BOLD = "\033[1m";
-    const char* UNDERLINE = "\033[4m";
-    const char* MAGENTA = "\033[35m";
-    const char* BLUE = "\033[34m";
+    // Lines below the page body: blank, position, up to five options, prompt.
+    constexpr size_t FOOTER_ROWS = 8;
+
     void enableVirtualTerminal() {
     #ifdef _WIN32
         HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -31,12 +33,100 @@ namespace {
     #endif
     }
 
-    std::string getExecutablePath() {
-        return std::filesystem::current_path().string();
+    constexpr size_t DEFAULT_PROFILE_RUNS = 10;
+    constexpr size_t MAX_PROFILE_RUNS = 1000;
+
+    std::string formatNumber(double value, int precision, int width = 0) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%*.*f", width, precision, value);
+        return text;
+    }
+
+    // Nearest-rank percentile of unsorted values.
+    double percentile(std::vector<double> values, double p) {
+        std::sort(values.begin(), values.end());
+        size_t rank = static_cast<size_t>(p / 100.0 * values.size() + 0.999999);
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+    }
+
+    double median(const DemoProfile& profile, const std::function<double(const DemoRunSample&)>& metric) {
+        std::vector<double> values;
+        for (const auto& sample : profile.samples) values.push_back(metric(sample));
+        return percentile(std::move(values), 50);
+    }
+
+    void addProfileTable(TerminalFrame& frame, const DemoProfile& profile) {
+        frame << BOLD << BLUE << "[" << profile.optFlag << "]" << RESET;
+        if (!profile.compiled) {
+            frame << RED << " compilation failed" << RESET << TerminalFrame::EOL;
+            return;
+        }
+        frame << " compiled in " << formatNumber(profile.compileSeconds, 2) << " s, "
+              << profile.samples.size() << " runs" << TerminalFrame::EOL;
+        if (!profile.runError.empty()) {
+            frame << RED << "  stopped: " << profile.runError << RESET << TerminalFrame::EOL;
+        }
+        if (profile.samples.empty()) return;
+        struct Metric {
+            const char* label;
+            int precision;
+            std::function<double(const DemoRunSample&)> value;
+        };
+        std::vector<Metric> metrics = {
+            {"wall (ms)", 3, [](const DemoRunSample& s) { return s.wallSeconds * 1e3; }},
+            {"user (ms)", 3, [](const DemoRunSample& s) { return s.userSeconds * 1e3; }},
+            {"sys (ms)", 3, [](const DemoRunSample& s) { return s.systemSeconds * 1e3; }},
+            {"max RSS (KB)", 0, [](const DemoRunSample& s) { return static_cast<double>(s.maxRssKb); }},
+        };
+        bool counters = std::all_of(profile.samples.begin(), profile.samples.end(),
+                                    [](const DemoRunSample& s) { return s.counters.available; });
+        if (counters) {
+            metrics.push_back({"cycles", 0, [](const DemoRunSample& s) { return static_cast<double>(s.counters.cycles); }});
+            metrics.push_back({"instructions", 0, [](const DemoRunSample& s) { return static_cast<double>(s.counters.instructions); }});
+            metrics.push_back({"cache misses", 0, [](const DemoRunSample& s) { return static_cast<double>(s.counters.cacheMisses); }});
+        }
+        frame << "  metric                median           p90           p99           min           max" << TerminalFrame::EOL;
+        for (const auto& metric : metrics) {
+            std::vector<double> values;
+            for (const auto& sample : profile.samples) values.push_back(metric.value(sample));
+            std::string label = metric.label;
+            label.resize(16, ' ');
+            frame << "  " << label;
+            for (double p : {50.0, 90.0, 99.0, 0.0, 100.0}) frame << formatNumber(percentile(values, p), metric.precision, 14);
+            frame << TerminalFrame::EOL;
+        }
+        if (!counters) frame << "  (hardware counters unavailable: perf_event_open not permitted or not supported)" << TerminalFrame::EOL;
+    }
+
+    // First line after the page starting at offset that fits in height rows.
+    size_t pageEnd(const std::vector<std::string>& lines, size_t offset, size_t height, size_t columns) {
+        size_t used = 0;
+        size_t end = offset;
+        while (end < lines.size()) {
+            size_t rows = TerminalFrame::rowsFor(lines[end], columns);
+            if (used + rows > height && end > offset) break;
+            used += rows;
+            ++end;
+        }
+        return end;
+    }
+
+    // Offset of the page that ends just before offset.
+    size_t pageStartBefore(const std::vector<std::string>& lines, size_t offset, size_t height, size_t columns) {
+        size_t used = 0;
+        size_t start = offset;
+        while (start > 0) {
+            size_t rows = TerminalFrame::rowsFor(lines[start - 1], columns);
+            if (used + rows > height && start < offset) break;
+            used += rows;
+            --start;
+        }
+        return start;
     }
 }
 
-Menu::Menu(TechniqueManager& manager) : manager(manager) {
+Menu::Menu(TechniqueManager& manager, bool usePch, const CatalogWatcher* watcher)
+    : manager(manager), usePch(usePch), watcher(watcher) {
     enableVirtualTerminal();
 }
 
@@ -44,131 +134,227 @@ void Menu::clearTerminal() const {
 #ifdef _WIN32
     std::system("cls");
 #else
-    std::system("clear");
+    // Home the cursor and clear screen + scrollback without spawning a shell.
+    std::cout << "\033[H\033[2J\033[3J" << std::flush;
 #endif
 }
 
+bool Menu::refreshCatalog() {
+    auto latest = manager.getCatalog();
+    if (latest == catalog) return false;
+    // The old snapshot is still alive here, so a technique address found in
+    // the new one really is the same (unchanged) technique.
+    if (dynamic_cast<const LiveCatalog*>(latest.get())) pages.retain(*latest);
+    else pages.clear();
+    catalog = std::move(latest);
+    return true;
+}
+
 void Menu::show() {
+    // Start from an empty screen once; later frames overwrite in place.
+    clearTerminal();
+    refreshCatalog();
     while (true) {
-        clearTerminal();
-        const auto& techniques = manager.getTechniques();
-        std::cout << BOLD << CYAN << "==================== MODERN C++ TECHNIQUES ====================" << RESET << "\n";
-        for (size_t i = 0; i < techniques.size(); ++i) {
-            std::cout << GREEN << (i + 1) << ". " << RESET << techniques[i].getName() << "\n";
+        bool reloaded = refreshCatalog();
+        size_t count = catalog->size();
+        TraceSpan span("menu.renderList");
+        frame.begin();
+        frame << BOLD << CYAN << "==================== MODERN C++ TECHNIQUES ====================" << RESET << TerminalFrame::EOL;
+        if (reloaded) frame << BLUE << "(catalog reloaded)" << RESET << TerminalFrame::EOL;
+        if (watcher && watcher->failureCount() != reportedFailures) {
+            // The previous catalog is still shown; say why the edit did not take.
+            reportedFailures = watcher->failureCount();
+            std::string errors = watcher->lastErrors();
+            TerminalFrame::forEachLine(errors, [&](std::string_view line) {
+                if (!line.empty()) frame << RED << "(reload failed) " << line << RESET << TerminalFrame::EOL;
+            });
+        }
+        for (size_t i = 0; i < count; ++i) {
+            frame << GREEN << (i + 1) << ". " << RESET << catalog->name(i) << TerminalFrame::EOL;
+        }
+        frame << BLUE << "s. Search" << RESET << TerminalFrame::EOL;
+        frame << YELLOW << "0. Exit" << RESET << TerminalFrame::EOL;
+        frame << TerminalFrame::EOL << "Select a technique: ";
+        frame.present();
+        span.end();
+        std::string input;
+        if (!(std::cin >> input)) break;
+        if (input == "s" || input == "S") {
+            showSearch();
+            continue;
         }
-        std::cout << YELLOW << "0. Exit" << RESET << "\n";
-        std::cout << "\nSelect a technique: ";
+        int choice = std::atoi(input.c_str());
+        if (input == "0") break;
+        if (choice < 1 || choice > (int)count) continue;
+        showTechniqueDetail(catalog->technique(choice - 1));
+    }
+}
+
+void Menu::showSearch() {
+    frame.begin();
+    frame << BOLD << CYAN << "Search: " << RESET;
+    frame.present();
+    std::string query;
+    std::cin.ignore();
+    std::getline(std::cin, query);
+    refreshCatalog();
+    auto hits = manager.search(catalog, query);
+    while (true) {
+        TraceSpan span("menu.renderSearchResults");
+        frame.begin();
+        frame << BOLD << CYAN << "Results for \"" << query << "\"" << RESET << TerminalFrame::EOL;
+        if (hits.empty()) frame << RED << "No matching technique." << RESET << TerminalFrame::EOL;
+        for (size_t i = 0; i < hits.size(); ++i) {
+            frame << GREEN << (i + 1) << ". " << RESET << catalog->name(hits[i].index)
+                  << "  (" << catalog->cppVersion(hits[i].index) << ")" << TerminalFrame::EOL;
+        }
+        frame << YELLOW << "0. Back to menu" << RESET << TerminalFrame::EOL << "Select: ";
+        frame.present();
+        span.end();
         int choice;
-        std::cin >> choice;
-        if (choice == 0) break;
-        if (choice < 1 || choice > (int)techniques.size()) continue;
-        showTechniqueDetail(techniques[choice - 1]);
+        if (!(std::cin >> choice) || choice == 0) break;
+        if (choice < 1 || choice > (int)hits.size()) continue;
+        showTechniqueDetail(catalog->technique(hits[choice - 1].index));
     }
 }
 
 void Menu::showTechniqueDetail(const Technique& tech) {
+    const std::vector<std::string>& page = pages.get(tech);
+    size_t offset = 0;
     while (true) {
-        clearTerminal();
-        std::cout << BOLD << UNDERLINE << YELLOW << "  " << tech.getName() << RESET << "  (" << GREEN << tech.getCppVersion() << RESET << ")\n";
-    
-        std::cout << BOLD << MAGENTA << " Definition: " << RESET << tech.getDefinition() << "\n";
-   
-        if (!tech.getUseCases().empty()) {
-            std::cout << BOLD << BLUE << " Use Cases:" << RESET << "\n";
-            for (const auto& uc : tech.getUseCases()) {
-                std::cout << "  - " << RESET << uc << "\n";
-            }
-        }
-      
-        std::cout << BOLD << YELLOW << " Syntax: " << RESET << tech.getSyntax() << "\n";
-        
-        std::cout << BOLD << UNDERLINE << RED << " Code Demo:" << RESET << "\n";
-        std::istringstream code_stream(tech.getDemoCode());
-        std::string code_line;
-        while (std::getline(code_stream, code_line)) {
-            std::cout << "  " << RESET << code_line << "\n";
-        }
-        
-        if (!tech.getExpectedOutput().empty()) {
-            std::cout << BOLD << GREEN << " Expected Output:" << RESET << "\n";
-            std::istringstream out_stream(tech.getExpectedOutput());
-            while (std::getline(out_stream, code_line)) {
-                std::cout << "  " << RESET << GREEN << code_line << RESET << "\n";
-            }
-        }
-        
-        if (!tech.getBestPractices().empty()) {
-            std::cout << BOLD << MAGENTA << " Best Practices:" << RESET << "\n";
-            for (const auto& bp : tech.getBestPractices()) {
-                std::cout << "  - " << RESET << bp << "\n";
-            }
-        }
-        
-        if (!tech.getAdvantages().empty()) {
-            std::cout << BOLD << YELLOW << " Advantages:" << RESET << "\n";
-            for (const auto& adv : tech.getAdvantages()) {
-                std::cout << "  - " << RESET << adv << "\n";
-            }
-        }
-        
-        if (!tech.getNotes().empty()) {
-            std::istringstream notes_stream(tech.getNotes());
-            while (std::getline(notes_stream, code_line)) {
-                std::cout << BOLD << BLUE << " Note: " << RESET << code_line << "\n";
-            }
+        size_t columns = frame.columns();
+        size_t rows = frame.rows();
+        size_t height = rows > FOOTER_ROWS ? rows - FOOTER_ROWS : 1;
+        size_t end = pageEnd(page, offset, height, columns);
+        bool paged = offset > 0 || end < page.size();
+
+        TraceSpan span("menu.renderDetail");
+        frame.begin();
+        for (size_t i = offset; i < end; ++i) frame << page[i] << TerminalFrame::EOL;
+        frame << TerminalFrame::EOL;
+        if (paged) {
+            frame << BLUE << "-- lines " << (offset + 1) << "-" << end << " of " << page.size() << " --"
+                  << RESET << TerminalFrame::EOL;
         }
-        
-        if (!tech.getDemoNote().empty()) {
-            std::istringstream demo_note_stream(tech.getDemoNote());
-            while (std::getline(demo_note_stream, code_line)) {
-                std::cout << BOLD << UNDERLINE << RED << " [Demo Note] " << RESET << code_line << "\n";
-            }
+        frame << GREEN << "1. Run code demo" << RESET << TerminalFrame::EOL;
+        frame << GREEN << "2. Profile demo" << RESET << TerminalFrame::EOL;
+        if (end < page.size()) frame << BLUE << "n. Next page" << RESET << TerminalFrame::EOL;
+        if (offset > 0) frame << BLUE << "p. Previous page" << RESET << TerminalFrame::EOL;
+        frame << YELLOW << "0. Back to menu" << RESET << TerminalFrame::EOL << "Select: ";
+        frame.present();
+        span.end();
+
+        std::string opt;
+        if (!(std::cin >> opt) || opt == "0") break;
+        if (opt == "1") {
+            runDemo(tech);
+        } else if (opt == "2") {
+            profileDemo(tech);
+        } else if ((opt == "n" || opt == "N") && end < page.size()) {
+            offset = end;
+        } else if ((opt == "p" || opt == "P") && offset > 0) {
+            offset = pageStartBefore(page, offset, height, columns);
         }
-        std::cout << "\n" << GREEN << "1. Run code demo" << RESET << "\n" << YELLOW << "0. Back to menu" << RESET << "\nSelect: ";
-        int opt;
-        std::cin >> opt;
-        if (opt == 0) break;
-        if (opt == 1) runDemo(tech);
     }
 }
 
 void Menu::runDemo(const Technique& tech) {
-    clearTerminal();
-    std::string filename = "demo_temp.cpp";
-    std::ofstream ofs(filename);
-    ofs << tech.getDemoCode();
-    ofs.close();
-    std::cout << CYAN << "Compiling and running demo..." << RESET << "\n";
-
-    // Tự động chọn chuẩn C++ phù hợp
-    std::string std_flag = "-std=c++17";
-    std::string code = tech.getDemoCode();
-    if (code.find("#include <coroutine>") != std::string::npos ||
-        code.find("#include <concepts>") != std::string::npos ||
-        code.find("#include <ranges>") != std::string::npos ||
-        code.find("<=>") != std::string::npos ||
-        code.find("concept ") != std::string::npos) {
-        std_flag = "-std=c++20";
-    }
-    if (code.find("this Self&&") != std::string::npos ||
-        code.find("#include <expected>") != std::string::npos ||
-        code.find(",") != std::string::npos) { // C++23 features
-        std_flag = "-std=c++23";
-    }
+    frame.begin();
+    frame << CYAN << "Compiling and running demo..." << RESET << TerminalFrame::EOL;
+    frame.present();
+    DemoRunner runner(&demoCache, usePch ? &demoPrelude : nullptr);
+    DemoResult result = runner.compileAndRun(tech.getDemoCode());
 
-    int compile = std::system(("g++ " + filename + " " + std_flag + " -o demo_temp.out 2> demo_temp.err").c_str());
-    if (compile != 0) {
-        std::ifstream err("demo_temp.err");
-        std::cout << RED << "[Compilation Error]\n" << err.rdbuf() << RESET << std::endl;
-        err.close();
+    TraceSpan span("menu.renderDemoResult");
+    frame.begin();
+    auto addBlock = [&](const char* color, std::string_view text) {
+        TerminalFrame::forEachLine(text, [&](std::string_view line) {
+            frame << color << line << RESET << TerminalFrame::EOL;
+        });
+    };
+    if (!result.compiled) {
+        frame << RED << "[Compilation Error]" << RESET << TerminalFrame::EOL;
+        addBlock(RED, result.compileErrors);
     } else {
-        std::cout << GREEN << "[Program Output]" << RESET << "\n";
-        std::system("./demo_temp.out");
+        frame << GREEN << "[Program Output]" << RESET << TerminalFrame::EOL;
+        addBlock(RESET, result.output);
+        addBlock(RED, result.errorOutput);
+        if (result.timedOut) {
+            frame << TerminalFrame::EOL << RED << "[Demo killed: time limit exceeded]" << RESET << TerminalFrame::EOL;
+        } else if (result.termSignal != 0) {
+            frame << TerminalFrame::EOL << RED << "[Demo killed by signal " << result.termSignal << "]" << RESET << TerminalFrame::EOL;
+        }
     }
-    std::remove("demo_temp.cpp");
-    std::remove("demo_temp.out");
-    std::remove("demo_temp.err");
-    std::cout << CYAN << "\nPress Enter to continue..." << RESET;
+    frame << TerminalFrame::EOL << BLUE << "[Demo cache] "
+          << (result.cacheHit ? "hit" : (result.usedPch ? "miss, compiled with precompiled prelude" : "miss"))
+          << " - " << demoCache.hits() << " hits, " << demoCache.misses() << " misses this session"
+          << RESET << TerminalFrame::EOL;
+    frame << TerminalFrame::EOL << CYAN << "Press Enter to continue..." << RESET;
+    frame.present();
+    span.end();
     std::cin.ignore();
     std::cin.get();
-} 
\ No newline at end of file
+}
+
+void Menu::profileDemo(const Technique& tech) {
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    // Each prompt is a new frame that repeats the earlier prompts with their
+    // answers: re-presenting a frame erases below it, echoed input included.
+    auto levelPrompt = [&] {
+        frame.begin();
+        frame << BOLD << CYAN << "Profile demo: " << tech.getName() << RESET << TerminalFrame::EOL
+              << "Optimization: " << GREEN << "0" << RESET << ") -O0  " << GREEN << "2" << RESET << ") -O2  "
+              << GREEN << "3" << RESET << ") -O3  " << GREEN << "c" << RESET << ") compare all three [2]: ";
+    };
+    levelPrompt();
+    frame.present();
+    std::string level;
+    std::getline(std::cin, level);
+    std::vector<std::string> flags;
+    if (level == "0") flags = {"-O0"};
+    else if (level == "3") flags = {"-O3"};
+    else if (level == "c" || level == "C") flags = {"-O0", "-O2", "-O3"};
+    else flags = {"-O2"};
+
+    levelPrompt();
+    frame << level << TerminalFrame::EOL << "Runs (1-" << MAX_PROFILE_RUNS << ") [" << DEFAULT_PROFILE_RUNS << "]: ";
+    frame.present();
+    std::string runsText;
+    std::getline(std::cin, runsText);
+    size_t runs = DEFAULT_PROFILE_RUNS;
+    if (int parsed = std::atoi(runsText.c_str()); parsed > 0) runs = std::min<size_t>(parsed, MAX_PROFILE_RUNS);
+
+    DemoRunner runner;
+    std::vector<DemoProfile> profiles;
+    for (const auto& flag : flags) {
+        frame.begin();
+        frame << CYAN << "Profiling " << tech.getName() << ": building with " << flag
+              << " and running " << runs << " times..." << RESET << TerminalFrame::EOL;
+        frame.present();
+        profiles.push_back(runner.profile(tech.getDemoCode(), flag, runs));
+    }
+
+    frame.begin();
+    frame << BOLD << CYAN << "Profile: " << tech.getName() << RESET << TerminalFrame::EOL;
+    for (const auto& profile : profiles) {
+        addProfileTable(frame, profile);
+        frame << TerminalFrame::EOL;
+    }
+    if (!profiles.front().compiled) {
+        frame << RED << profiles.front().compileErrors << RESET << TerminalFrame::EOL;
+    }
+    if (profiles.size() > 1 && !profiles.front().samples.empty()) {
+        auto wall = [](const DemoRunSample& s) { return s.wallSeconds; };
+        double baseline = median(profiles.front(), wall);
+        frame << BOLD << "Median wall time vs " << profiles.front().optFlag << ":" << RESET;
+        for (const auto& profile : profiles) {
+            if (profile.samples.empty()) continue;
+            double ratio = median(profile, wall) / baseline;
+            frame << "  " << profile.optFlag << " " << formatNumber(ratio, 2) << "x";
+        }
+        frame << TerminalFrame::EOL;
+    }
+    frame << CYAN << "Press Enter to continue..." << RESET;
+    frame.present();
+    std::cin.get();
+}
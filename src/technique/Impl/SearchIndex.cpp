@@ -0,0 +1,219 @@
+#include "../Header/SearchIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace {
+    // Relative importance of each field in the ranking.
+    constexpr float NAME_WEIGHT = 8.0f;
+    constexpr float DEFINITION_WEIGHT = 3.0f;
+    constexpr float USE_CASE_WEIGHT = 2.0f;
+    constexpr float LIST_WEIGHT = 1.0f;
+    constexpr float CODE_WEIGHT = 0.5f;
+
+    constexpr double PREFIX_FACTOR = 0.7;
+    constexpr double FUZZY_FACTOR = 0.5;
+    constexpr size_t MAX_PREFIX_EXPANSIONS = 64;
+
+    bool isTokenChar(unsigned char c) {
+        // Bytes >= 0x80 keep UTF-8 words (e.g. Vietnamese text) in one token.
+        return std::isalnum(c) || c == '_' || c >= 0x80;
+    }
+
+    int maxEditsFor(size_t length) {
+        if (length <= 2) return 0;
+        return length <= 5 ? 1 : 2;
+    }
+
+    std::vector<std::string> trigramsOf(std::string_view term) {
+        std::string padded;
+        padded.reserve(term.size() + 2);
+        padded.append(1, '^').append(term).append(1, '$');
+        std::vector<std::string> grams;
+        for (size_t i = 0; i + 3 <= padded.size(); ++i) grams.push_back(padded.substr(i, 3));
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+}
+
+std::vector<std::string> SearchIndex::tokenize(std::string_view text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (unsigned char c : text) {
+        if (isTokenChar(c)) {
+            current += static_cast<char>(std::tolower(c));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(std::move(current));
+    return tokens;
+}
+
+int SearchIndex::editDistance(std::string_view a, std::string_view b, int maxDistance) {
+    // Optimal string alignment distance (adjacent transpositions count as one
+    // edit), abandoned as soon as a whole row exceeds maxDistance.
+    if (static_cast<int>(a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()) > maxDistance) {
+        return maxDistance + 1;
+    }
+    std::vector<int> prev2(b.size() + 1), prev(b.size() + 1), row(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) prev[j] = static_cast<int>(j);
+    for (size_t i = 1; i <= a.size(); ++i) {
+        row[0] = static_cast<int>(i);
+        int rowMin = row[0];
+        for (size_t j = 1; j <= b.size(); ++j) {
+            int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            row[j] = std::min({prev[j] + 1, row[j - 1] + 1, prev[j - 1] + cost});
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                row[j] = std::min(row[j], prev2[j - 2] + 1);
+            }
+            rowMin = std::min(rowMin, row[j]);
+        }
+        if (rowMin > maxDistance) return maxDistance + 1;
+        std::swap(prev2, prev);
+        std::swap(prev, row);
+    }
+    return prev[b.size()];
+}
+
+void SearchIndex::build(const ICatalog& catalog) {
+    documentCount = catalog.size();
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<std::string> rawTerms;
+    std::vector<std::vector<Posting>> rawPostings;
+    std::unordered_map<uint32_t, float> docWeights;
+
+    auto add = [&](std::string_view text, float weight) {
+        for (auto& token : tokenize(text)) {
+            auto [it, inserted] = ids.try_emplace(token, static_cast<uint32_t>(rawTerms.size()));
+            if (inserted) {
+                rawTerms.push_back(std::move(token));
+                rawPostings.emplace_back();
+            }
+            docWeights[it->second] += weight;
+        }
+    };
+
+    auto weightOf = [](TextField field) {
+        switch (field) {
+        case TextField::Name: return NAME_WEIGHT;
+        case TextField::Definition: return DEFINITION_WEIGHT;
+        case TextField::UseCase: return USE_CASE_WEIGHT;
+        case TextField::BestPractice:
+        case TextField::Advantage: return LIST_WEIGHT;
+        case TextField::DemoCode: return CODE_WEIGHT;
+        }
+        return LIST_WEIGHT;
+    };
+
+    for (size_t doc = 0; doc < documentCount; ++doc) {
+        docWeights.clear();
+        catalog.visitText(doc, [&](TextField field, std::string_view text) { add(text, weightOf(field)); });
+        for (const auto& [term, weight] : docWeights) {
+            // Dampen repetition so a long demo cannot drown out the name.
+            rawPostings[term].push_back({static_cast<uint32_t>(doc), 1.0f + std::log(weight)});
+        }
+    }
+
+    std::vector<uint32_t> order(rawTerms.size());
+    for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return rawTerms[a] < rawTerms[b]; });
+    terms.clear();
+    postings.clear();
+    trigrams.clear();
+    terms.reserve(order.size());
+    postings.reserve(order.size());
+    for (uint32_t old : order) {
+        terms.push_back(std::move(rawTerms[old]));
+        postings.push_back(std::move(rawPostings[old]));
+    }
+    for (uint32_t id = 0; id < terms.size(); ++id) addTrigrams(id);
+}
+
+void SearchIndex::addTrigrams(uint32_t termId) {
+    for (auto& gram : trigramsOf(terms[termId])) trigrams[gram].push_back(termId);
+}
+
+double SearchIndex::idf(uint32_t termId) const {
+    return std::log(1.0 + static_cast<double>(documentCount) / static_cast<double>(postings[termId].size()));
+}
+
+std::vector<std::pair<uint32_t, int>> SearchIndex::fuzzyTerms(const std::string& token) const {
+    std::vector<std::pair<uint32_t, int>> matches;
+    int maxEdits = maxEditsFor(token.size());
+    if (maxEdits == 0) return matches;
+    // A substitution, insertion or deletion touches at most three trigrams
+    // and an adjacent transposition (one edit under OSA) up to four, which
+    // bounds how many a candidate within maxEdits must still share with the token.
+    auto grams = trigramsOf(token);
+    int required = std::max(1, static_cast<int>(grams.size()) - 4 * maxEdits);
+    std::unordered_map<uint32_t, int> shared;
+    for (const auto& gram : grams) {
+        auto it = trigrams.find(gram);
+        if (it == trigrams.end()) continue;
+        for (uint32_t id : it->second) ++shared[id];
+    }
+    for (const auto& [id, count] : shared) {
+        if (count < required) continue;
+        int distance = editDistance(token, terms[id], maxEdits);
+        if (distance > 0 && distance <= maxEdits) matches.emplace_back(id, distance);
+    }
+    return matches;
+}
+
+std::vector<SearchHit> SearchIndex::search(std::string_view query, size_t limit) const {
+    auto tokens = tokenize(query);
+    if (tokens.empty() || terms.empty()) return {};
+    std::unordered_map<uint32_t, double> scores;
+    std::unordered_map<uint32_t, size_t> matchedTokens;
+
+    for (const auto& token : tokens) {
+        std::unordered_map<uint32_t, double> best;
+        auto apply = [&](uint32_t termId, double factor) {
+            double termIdf = idf(termId);
+            for (const Posting& p : postings[termId]) {
+                double score = p.weight * termIdf * factor;
+                double& slot = best[p.doc];
+                slot = std::max(slot, score);
+            }
+        };
+        auto it = std::lower_bound(terms.begin(), terms.end(), token);
+        size_t expansions = 0;
+        for (auto prefix = it; prefix != terms.end() && prefix->compare(0, token.size(), token) == 0; ++prefix) {
+            uint32_t id = static_cast<uint32_t>(prefix - terms.begin());
+            if (*prefix == token) {
+                apply(id, 1.0);
+                continue;
+            }
+            // Terms are sorted, so the rest of the range only holds more expansions.
+            if (expansions++ == MAX_PREFIX_EXPANSIONS) break;
+            apply(id, PREFIX_FACTOR);
+        }
+        for (const auto& [id, distance] : fuzzyTerms(token)) apply(id, FUZZY_FACTOR / distance);
+        for (const auto& [doc, score] : best) {
+            scores[doc] += score;
+            ++matchedTokens[doc];
+        }
+    }
+
+    std::vector<SearchHit> hits;
+    hits.reserve(scores.size());
+    for (const auto& [doc, score] : scores) {
+        // Documents that match every query word rank above partial matches.
+        double coverage = static_cast<double>(matchedTokens[doc]) / tokens.size();
+        hits.push_back({doc, score * coverage * coverage});
+    }
+    auto better = [](const SearchHit& a, const SearchHit& b) {
+        return a.score != b.score ? a.score > b.score : a.index < b.index;
+    };
+    size_t keep = std::min(limit, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + keep, hits.end(), better);
+    hits.resize(keep);
+    return hits;
+}
+
+size_t SearchIndex::termCount() const {
+    return terms.size();
+}
@@ -0,0 +1,155 @@
+#include "../Header/ShardLoader.h"
+#include "../Header/TechniqueParser.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <glob.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+    struct ShardFeature {
+        std::string id;
+        std::string section;
+        size_t shard = 0;
+        size_t position = 0;
+        uint64_t hash = 0;
+        std::shared_ptr<const Technique> technique;
+    };
+
+    struct Shard {
+        int priority = 0;
+        std::vector<ShardFeature> features;
+        std::string error;
+    };
+
+    Shard parseShard(const std::string& path, size_t shardIndex, const ShardLoader::Reuse& reuse) {
+        TraceSpan span("catalog.parseShard");
+        Shard shard;
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            shard.error = "cannot open";
+            return shard;
+        }
+        json j = json::parse(file, nullptr, false);
+        if (j.is_discarded() || !j.contains("cpp_modern_features")) {
+            shard.error = "not a catalog file";
+            return shard;
+        }
+        try {
+            const auto& features_root = j["cpp_modern_features"];
+            if (features_root.contains("metadata") && features_root["metadata"].contains("priority")) {
+                shard.priority = features_root["metadata"]["priority"].get<int>();
+            }
+            size_t position = 0;
+            for (const auto& version_key : TechniqueParser::sectionKeys(features_root)) {
+                const auto& version = features_root[version_key];
+                std::string cpp_version = version.value("version", "");
+                for (const auto& item : version["features"]) {
+                    ShardFeature feature{item.value("id", item.value("name", "")), version_key, shardIndex,
+                                         position++, TechniqueParser::contentHash(item, cpp_version), nullptr};
+                    if (reuse) feature.technique = reuse(feature.id, feature.hash);
+                    if (!feature.technique) {
+                        feature.technique = std::make_shared<const Technique>(TechniqueParser::fromJson(item, cpp_version));
+                    }
+                    shard.features.push_back(std::move(feature));
+                }
+            }
+        } catch (const json::exception& e) {
+            shard.features.clear();
+            shard.error = e.what();
+        }
+        return shard;
+    }
+}
+
+bool ShardLoader::isShardSet(const std::string& pattern) {
+    std::error_code ec;
+    return std::filesystem::is_directory(pattern, ec) || pattern.find_first_of("*?[") != std::string::npos;
+}
+
+std::vector<std::string> ShardLoader::expand(const std::string& pattern) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    if (std::filesystem::is_directory(pattern, ec)) {
+        for (const auto& entry : std::filesystem::directory_iterator(pattern, ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == ".json") {
+                files.push_back(entry.path().string());
+            }
+        }
+    } else {
+        glob_t matches;
+        if (glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+            for (size_t i = 0; i < matches.gl_pathc; ++i) files.push_back(matches.gl_pathv[i]);
+        }
+        globfree(&matches);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+bool ShardLoader::load(const std::vector<std::string>& shards, std::vector<Technique>& techniques,
+                       ShardLoadReport& report, size_t threads) {
+    std::vector<ShardEntry> entries;
+    if (!loadEntries(shards, entries, report, {}, threads)) return false;
+    techniques.clear();
+    techniques.reserve(entries.size());
+    for (const auto& entry : entries) techniques.push_back(*entry.technique);
+    return true;
+}
+
+bool ShardLoader::loadEntries(const std::vector<std::string>& shards, std::vector<ShardEntry>& entries,
+                              ShardLoadReport& report, const Reuse& reuse, size_t threads) {
+    report = ShardLoadReport();
+    report.shards = shards.size();
+    std::vector<Shard> parsed(shards.size());
+    {
+        ThreadPool pool(std::min(threads ? threads : ThreadPool::defaultThreadCount(), std::max<size_t>(shards.size(), 1)));
+        for (size_t i = 0; i < shards.size(); ++i) {
+            pool.submit([&, i] { parsed[i] = parseShard(shards[i], i, reuse); });
+        }
+        pool.waitIdle();
+    }
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (!parsed[i].error.empty()) report.errors += shards[i] + ": " + parsed[i].error + "\n";
+    }
+    if (!report.errors.empty()) return false;
+
+    // Shards are visited in path order, so "later" below means later path.
+    // An override keeps the slot of the feature it replaces.
+    struct Slot {
+        ShardFeature* winner;
+        size_t shard;
+        size_t position;
+    };
+    std::unordered_map<std::string, Slot> winners;
+    for (auto& shard : parsed) {
+        for (auto& feature : shard.features) {
+            auto [it, inserted] = winners.try_emplace(feature.id, Slot{&feature, feature.shard, feature.position});
+            if (inserted) continue;
+            ++report.duplicates;
+            if (shard.priority >= parsed[it->second.winner->shard].priority) it->second.winner = &feature;
+        }
+    }
+    std::vector<Slot> merged;
+    merged.reserve(winners.size());
+    for (const auto& [id, slot] : winners) merged.push_back(slot);
+    std::sort(merged.begin(), merged.end(), [](const Slot& a, const Slot& b) {
+        if (a.winner->section != b.winner->section) return TechniqueParser::sectionBefore(a.winner->section, b.winner->section);
+        if (a.shard != b.shard) return a.shard < b.shard;
+        return a.position < b.position;
+    });
+
+    entries.clear();
+    entries.reserve(merged.size());
+    for (const Slot& slot : merged) {
+        ShardFeature& winner = *slot.winner;
+        entries.push_back({std::move(winner.id), winner.hash, std::move(winner.technique)});
+    }
+    report.features = entries.size();
+    return true;
+}
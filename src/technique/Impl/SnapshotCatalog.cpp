@@ -0,0 +1,276 @@
+#include "../Header/SnapshotCatalog.h"
+#include "Hash.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+    struct SourceInfo {
+        bool exists = false;
+        uint64_t size = 0;
+        int64_t mtime = 0;
+    };
+
+    SourceInfo statSource(const std::string& path) {
+        SourceInfo info;
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            info.exists = true;
+            info.size = static_cast<uint64_t>(st.st_size);
+            info.mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+        }
+        return info;
+    }
+
+    uint64_t hashFile(const std::string& path) {
+        MappedFile source;
+        if (!source.open(path)) return 0;
+        return Hash::fnv1a64(source.view());
+    }
+
+    uint64_t hashBytes(const void* data, size_t size) {
+        return Hash::fnv1a64(std::string_view(static_cast<const char*>(data), size));
+    }
+
+    uint64_t headerChecksum(const SnapshotCatalog::SnapshotHeader& header) {
+        return hashBytes(&header, offsetof(SnapshotCatalog::SnapshotHeader, headerChecksum));
+    }
+
+    size_t alignUp(size_t value) {
+        return (value + 7) & ~size_t(7);
+    }
+
+    // Appends strings to the blob, storing identical short strings (versions,
+    // categories, empty fields...) only once. Long texts are rarely repeated
+    // and are not worth hashing.
+    class BlobBuilder {
+    public:
+        static constexpr size_t DEDUP_LIMIT = 64;
+
+        SnapshotCatalog::StringRef add(const std::string& text) {
+            if (text.size() > DEDUP_LIMIT) return append(text);
+            auto it = offsets.find(text);
+            if (it != offsets.end()) return {it->second, text.size()};
+            SnapshotCatalog::StringRef ref = append(text);
+            offsets.emplace(text, ref.offset);
+            return ref;
+        }
+        const std::string& data() const { return blob; }
+    private:
+        SnapshotCatalog::StringRef append(const std::string& text) {
+            uint64_t offset = blob.size();
+            blob += text;
+            return {offset, text.size()};
+        }
+
+        std::string blob;
+        std::unordered_map<std::string, uint64_t> offsets;
+    };
+}
+
+bool SnapshotCatalog::write(const ICatalog& catalog, const std::string& snapshotPath, const std::string& sourcePath) {
+    BlobBuilder blob;
+    std::vector<SnapshotRecord> recordTable(catalog.size());
+    std::vector<StringRef> listTable;
+    for (size_t i = 0; i < catalog.size(); ++i) {
+        const Technique& tech = catalog.technique(i);
+        SnapshotRecord& record = recordTable[i];
+        record.fields[NAME] = blob.add(tech.getName());
+        record.fields[DEFINITION] = blob.add(tech.getDefinition());
+        record.fields[USAGE] = blob.add(tech.getUsage());
+        record.fields[SYNTAX] = blob.add(tech.getSyntax());
+        record.fields[DEMO_CODE] = blob.add(tech.getDemoCode());
+        record.fields[CPP_VERSION] = blob.add(tech.getCppVersion());
+        record.fields[NOTES] = blob.add(tech.getNotes());
+        record.fields[DEMO_NOTE] = blob.add(tech.getDemoNote());
+        record.fields[EXPECTED_OUTPUT] = blob.add(tech.getExpectedOutput());
+        const std::vector<std::string>* lists[LIST_COUNT] = {
+            &tech.getUseCases(), &tech.getBestPractices(), &tech.getAdvantages()
+        };
+        for (int list = 0; list < LIST_COUNT; ++list) {
+            record.lists[list] = {listTable.size(), lists[list]->size()};
+            for (const auto& item : *lists[list]) listTable.push_back(blob.add(item));
+        }
+    }
+
+    SnapshotHeader head{};
+    std::memcpy(head.magic, MAGIC, sizeof(MAGIC));
+    head.formatVersion = FORMAT_VERSION;
+    head.byteOrder = BYTE_ORDER_MARK;
+    head.recordCount = recordTable.size();
+    head.listItemCount = listTable.size();
+    head.blobSize = blob.data().size();
+    head.recordsOffset = alignUp(sizeof(SnapshotHeader));
+    head.listsOffset = alignUp(head.recordsOffset + recordTable.size() * sizeof(SnapshotRecord));
+    head.blobOffset = alignUp(head.listsOffset + listTable.size() * sizeof(StringRef));
+    SourceInfo source = statSource(sourcePath);
+    head.sourceSize = source.size;
+    head.sourceMtime = source.mtime;
+    head.sourceHash = source.exists ? hashFile(sourcePath) : 0;
+    uint64_t tableHash = hashBytes(recordTable.data(), recordTable.size() * sizeof(SnapshotRecord));
+    head.tableChecksum = Hash::fnv1a64(std::string_view(reinterpret_cast<const char*>(listTable.data()),
+                                                        listTable.size() * sizeof(StringRef)), tableHash);
+    head.blobChecksum = Hash::fnv1a64(blob.data());
+    head.headerChecksum = headerChecksum(head);
+
+    // Write to a temporary file and rename, so running instances that still
+    // map the old snapshot are not disturbed.
+    std::string tmpPath = snapshotPath + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        auto pad = [&out](uint64_t offset) {
+            while (static_cast<uint64_t>(out.tellp()) < offset) out.put('\0');
+        };
+        out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+        pad(head.recordsOffset);
+        out.write(reinterpret_cast<const char*>(recordTable.data()), recordTable.size() * sizeof(SnapshotRecord));
+        pad(head.listsOffset);
+        out.write(reinterpret_cast<const char*>(listTable.data()), listTable.size() * sizeof(StringRef));
+        pad(head.blobOffset);
+        out.write(blob.data().data(), blob.data().size());
+        if (!out) {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), snapshotPath.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotCatalog::open(const std::string& snapshotPath, const std::string& sourcePath) {
+    header = nullptr;
+    if (!file.open(snapshotPath)) return false;
+    auto fail = [this] {
+        file.close();
+        header = nullptr;
+        return false;
+    };
+    const char* base = file.begin();
+    size_t size = file.size();
+    if (size < sizeof(SnapshotHeader)) return fail();
+    const auto* head = reinterpret_cast<const SnapshotHeader*>(base);
+    if (std::memcmp(head->magic, MAGIC, sizeof(MAGIC)) != 0 || head->formatVersion != FORMAT_VERSION ||
+        head->byteOrder != BYTE_ORDER_MARK || head->headerChecksum != headerChecksum(*head)) {
+        return fail();
+    }
+
+    // Bounds of every section, then of every reference into them, so that
+    // later accessors can index without checks.
+    auto fits = [size](uint64_t offset, uint64_t count, uint64_t width) {
+        return offset <= size && count <= (size - offset) / width && offset % 8 == 0;
+    };
+    if (!fits(head->recordsOffset, head->recordCount, sizeof(SnapshotRecord)) ||
+        !fits(head->listsOffset, head->listItemCount, sizeof(StringRef)) ||
+        head->blobOffset > size || head->blobSize > size - head->blobOffset) {
+        return fail();
+    }
+    const auto* recordTable = reinterpret_cast<const SnapshotRecord*>(base + head->recordsOffset);
+    const auto* listTable = reinterpret_cast<const StringRef*>(base + head->listsOffset);
+    uint64_t tableHash = hashBytes(recordTable, head->recordCount * sizeof(SnapshotRecord));
+    tableHash = Hash::fnv1a64(std::string_view(reinterpret_cast<const char*>(listTable),
+                                               head->listItemCount * sizeof(StringRef)), tableHash);
+    if (tableHash != head->tableChecksum) return fail();
+    auto validRef = [head](const StringRef& ref) {
+        return ref.offset <= head->blobSize && ref.length <= head->blobSize - ref.offset;
+    };
+    for (uint64_t i = 0; i < head->listItemCount; ++i) {
+        if (!validRef(listTable[i])) return fail();
+    }
+    for (uint64_t i = 0; i < head->recordCount; ++i) {
+        for (const auto& ref : recordTable[i].fields) {
+            if (!validRef(ref)) return fail();
+        }
+        for (const auto& list : recordTable[i].lists) {
+            if (list.first > head->listItemCount || list.count > head->listItemCount - list.first) return fail();
+        }
+    }
+
+    SourceInfo source = statSource(sourcePath);
+    if (source.exists) {
+        if (source.size != head->sourceSize) return fail();
+        // A copied or touched JSON changes mtime without changing content.
+        if (source.mtime != head->sourceMtime && hashFile(sourcePath) != head->sourceHash) return fail();
+    }
+
+    header = head;
+    records = recordTable;
+    listItems = listTable;
+    blob = base + head->blobOffset;
+    materialized.clear();
+    materialized.resize(head->recordCount);
+    return true;
+}
+
+bool SnapshotCatalog::verifyBlob() const {
+    return header && Hash::fnv1a64(std::string_view(blob, header->blobSize)) == header->blobChecksum;
+}
+
+std::string_view SnapshotCatalog::resolve(const StringRef& ref) const {
+    return {blob + ref.offset, static_cast<size_t>(ref.length)};
+}
+
+size_t SnapshotCatalog::size() const {
+    return header ? header->recordCount : 0;
+}
+
+std::string_view SnapshotCatalog::field(size_t index, Field field) const {
+    return resolve(records[index].fields[field]);
+}
+
+size_t SnapshotCatalog::listSize(size_t index, List list) const {
+    return records[index].lists[list].count;
+}
+
+std::string_view SnapshotCatalog::listItem(size_t index, List list, size_t item) const {
+    return resolve(listItems[records[index].lists[list].first + item]);
+}
+
+std::string_view SnapshotCatalog::name(size_t index) const {
+    return field(index, NAME);
+}
+
+std::string_view SnapshotCatalog::cppVersion(size_t index) const {
+    return field(index, CPP_VERSION);
+}
+
+std::vector<std::string> SnapshotCatalog::listToVector(size_t index, List list) const {
+    std::vector<std::string> items;
+    items.reserve(listSize(index, list));
+    for (size_t i = 0; i < listSize(index, list); ++i) items.emplace_back(listItem(index, list, i));
+    return items;
+}
+
+const Technique& SnapshotCatalog::technique(size_t index) const {
+    std::lock_guard<std::mutex> lock(materializeMutex);
+    if (!materialized[index]) {
+        auto text = [&](Field f) { return std::string(field(index, f)); };
+        materialized[index] = std::make_unique<Technique>(
+            text(NAME), text(DEFINITION), text(USAGE), text(SYNTAX), text(DEMO_CODE),
+            text(CPP_VERSION), text(NOTES), text(DEMO_NOTE),
+            listToVector(index, USE_CASES), listToVector(index, BEST_PRACTICES),
+            listToVector(index, ADVANTAGES), text(EXPECTED_OUTPUT));
+    }
+    return *materialized[index];
+}
+
+void SnapshotCatalog::visitText(size_t index, const TextVisitor& visit) const {
+    // Straight from the mapped blob; nothing is materialized.
+    auto list = [&](List which, TextField as) {
+        for (size_t i = 0; i < listSize(index, which); ++i) visit(as, listItem(index, which, i));
+    };
+    visit(TextField::Name, field(index, NAME));
+    visit(TextField::Definition, field(index, DEFINITION));
+    list(USE_CASES, TextField::UseCase);
+    list(BEST_PRACTICES, TextField::BestPractice);
+    list(ADVANTAGES, TextField::Advantage);
+    visit(TextField::DemoCode, field(index, DEMO_CODE));
+}
@@ -1,17 +1,18 @@
 #include "../Header/Technique.h"
 
-Technique::Technique(const std::string& name, const std::string& definition,
-                     const std::string& usage, const std::string& syntax,
-                     const std::string& demo_code, const std::string& cpp_version,
-                     const std::string& notes, const std::string& demo_note,
-                     const std::vector<std::string>& use_cases,
-                     const std::vector<std::string>& best_practices,
-                     const std::vector<std::string>& advantages,
-                     const std::string& expected_output)
-    : name(name), definition(definition), usage(usage), syntax(syntax), demo_code(demo_code),
-      cpp_version(cpp_version), notes(notes), demo_note(demo_note),
-      use_cases(use_cases), best_practices(best_practices), advantages(advantages),
-      expected_output(expected_output) {}
+Technique::Technique(std::string name, std::string definition,
+                     std::string usage, std::string syntax,
+                     std::string demo_code, std::string cpp_version,
+                     std::string notes, std::string demo_note,
+                     std::vector<std::string> use_cases,
+                     std::vector<std::string> best_practices,
+                     std::vector<std::string> advantages,
+                     std::string expected_output)
+    : name(std::move(name)), definition(std::move(definition)), usage(std::move(usage)),
+      syntax(std::move(syntax)), demo_code(std::move(demo_code)), cpp_version(std::move(cpp_version)),
+      notes(std::move(notes)), demo_note(std::move(demo_note)), use_cases(std::move(use_cases)),
+      best_practices(std::move(best_practices)), advantages(std::move(advantages)),
+      expected_output(std::move(expected_output)) {}
 
 const std::string& Technique::getName() const {
     return name;
@@ -1,67 +1,102 @@
 #include "../Header/TechniqueManager.h"
+#include "../Header/ArenaCatalog.h"
+#include "../Header/LazyJsonCatalog.h"
+#ifdef CMT_EMBED_CATALOG
+#include "../Header/EmbeddedCatalog.h"
+#endif
+#include "../Header/SnapshotCatalog.h"
+#include "../Header/TechniqueParser.h"
+#include "../Header/VectorCatalog.h"
+#include "Trace.h"
+#include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
 bool TechniqueManager::loadFromJson(const std::string& filename) {
+    TraceSpan span("catalog.loadFromJson");
     std::ifstream file(filename);
     if (!file.is_open()) return false;
     json j;
-    file >> j;
-    techniques.clear();
+    {
+        TraceSpan parse("catalog.parseJson");
+        file >> j;
+    }
+    TraceSpan build("catalog.buildTechniques");
+    std::vector<Technique> techniques;
     if (!j.contains("cpp_modern_features")) return false;
     auto& features_root = j["cpp_modern_features"];
-    for (const auto& version_key : {"cpp17_features", "cpp20_features", "cpp23_features"}) {
-        if (!features_root.contains(version_key)) continue;
+    for (const auto& version_key : TechniqueParser::sectionKeys(features_root)) {
         const auto& version = features_root[version_key];
         std::string cpp_version = version.value("version", "");
-        if (!version.contains("features")) continue;
         for (const auto& item : version["features"]) {
-            std::string name = item.value("name", "");
-            std::string definition = item.value("definition", "");
-            std::string usage;
-            if (item.contains("primary_use_cases")) {
-                usage = "- " + joinVector(item["primary_use_cases"].get<std::vector<std::string>>(), "\n- ");
-            }
-            std::string syntax;
-            if (item.contains("syntax")) {
-                if (item["syntax"].is_object()) {
-                    for (auto it = item["syntax"].begin(); it != item["syntax"].end(); ++it) {
-                        syntax += it.key() + ": " + it.value().get<std::string>() + "\n";
-                    }
-                } else if (item["syntax"].is_string()) {
-                    syntax = item["syntax"].get<std::string>();
-                }
-            }
-            std::string demo_code;
-            std::string expected_output;
-            if (item.contains("complete_demo")) {
-                if (item["complete_demo"].contains("code"))
-                    demo_code = item["complete_demo"]["code"].get<std::string>();
-                if (item["complete_demo"].contains("expected_output"))
-                    expected_output = item["complete_demo"]["expected_output"].get<std::string>();
-            }
-            std::string notes;
-            if (item.contains("category")) notes += "Category: " + item["category"].get<std::string>() + "\n";
-            if (item.contains("complexity_level")) notes += "Level: " + item["complexity_level"].get<std::string>() + "\n";
-            if (item.contains("key_improvements")) notes += "Improvements: " + item["key_improvements"].get<std::string>() + "\n";
-            std::string demo_note;
-            std::vector<std::string> use_cases;
-            if (item.contains("primary_use_cases")) use_cases = item["primary_use_cases"].get<std::vector<std::string>>();
-            std::vector<std::string> best_practices;
-            if (item.contains("best_practices")) best_practices = item["best_practices"].get<std::vector<std::string>>();
-            std::vector<std::string> advantages;
-            if (item.contains("advantages")) advantages = item["advantages"].get<std::vector<std::string>>();
-            techniques.emplace_back(
-                name, definition, usage, syntax, demo_code, cpp_version, notes, demo_note,
-                use_cases, best_practices, advantages, expected_output
-            );
+            techniques.push_back(TechniqueParser::fromJson(item, cpp_version));
         }
     }
+    Trace::counter("catalog.techniques", static_cast<int64_t>(techniques.size()));
+    catalog = std::make_shared<VectorCatalog>(std::move(techniques));
+    return true;
+}
+
+bool TechniqueManager::loadFromJsonLazy(const std::string& filename) {
+    TraceSpan span("catalog.loadFromJsonLazy");
+    auto lazy = std::make_shared<LazyJsonCatalog>();
+    if (!lazy->open(filename)) return false;
+    catalog = std::move(lazy);
+    return true;
+}
+
+bool TechniqueManager::loadFromJsonArena(const std::string& filename) {
+    TraceSpan span("catalog.loadFromJsonArena");
+    auto arena = std::make_shared<ArenaCatalog>();
+    if (!arena->load(filename)) return false;
+    catalog = std::move(arena);
+    return true;
+}
+
+bool TechniqueManager::loadFromSnapshot(const std::string& snapshotPath, const std::string& sourcePath) {
+    TraceSpan span("catalog.loadFromSnapshot");
+    auto snapshot = std::make_shared<SnapshotCatalog>();
+    if (!snapshot->open(snapshotPath, sourcePath)) return false;
+    catalog = std::move(snapshot);
+    return true;
+}
+
+bool TechniqueManager::loadFromShards(const std::string& pattern, ShardLoadReport& report, CatalogDiff* diff) {
+    TraceSpan span("catalog.loadFromShards");
+    std::vector<std::string> shards = ShardLoader::expand(pattern);
+    if (shards.empty()) {
+        report = ShardLoadReport();
+        report.errors = pattern + ": no catalog files found\n";
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    auto current = catalog.load();
+    auto live = std::make_shared<LiveCatalog>();
+    if (!live->loadShards(shards, report, dynamic_cast<const LiveCatalog*>(current.get()), diff)) return false;
+    catalog.store(std::move(live));
     return true;
 }
 
+bool TechniqueManager::loadCatalog(const std::string& jsonPath) {
+    return loadFromSnapshot(snapshotPathFor(jsonPath), jsonPath) || loadFromJsonLazy(jsonPath);
+}
+
+std::string TechniqueManager::snapshotPathFor(const std::string& jsonPath) {
+    return std::filesystem::path(jsonPath).replace_extension(".cat").string();
+}
+
+bool TechniqueManager::loadEmbedded() {
+#ifdef CMT_EMBED_CATALOG
+    // Aliasing constructor with an empty owner: points at the static table
+    // without allocating a control block.
+    catalog = std::shared_ptr<const ICatalog>(std::shared_ptr<const ICatalog>(), &EmbeddedCatalog::instance());
+    return true;
+#else
+    return false;
+#endif
+}
 
 std::string TechniqueManager::joinVector(const std::vector<std::string>& vec, const std::string& sep) {
     std::string result;
@@ -72,6 +107,59 @@ std::string TechniqueManager::joinVector(const std::vector<std::string>& vec, co
     return result;
 }
 
-const std::vector<Technique>& TechniqueManager::getTechniques() const {
-    return techniques;
-} 
\ No newline at end of file
+size_t TechniqueManager::size() const {
+    auto current = catalog.load();
+    return current ? current->size() : 0;
+}
+
+std::string TechniqueManager::nameAt(size_t index) const {
+    return std::string(catalog.load()->name(index));
+}
+
+std::string TechniqueManager::versionAt(size_t index) const {
+    return std::string(catalog.load()->cppVersion(index));
+}
+
+const Technique& TechniqueManager::getTechnique(size_t index) const {
+    return catalog.load()->technique(index);
+}
+
+std::vector<SearchHit> TechniqueManager::search(std::string_view query, size_t limit) const {
+    return search(getCatalog(), query, limit);
+}
+
+std::vector<SearchHit> TechniqueManager::search(const std::shared_ptr<const ICatalog>& snapshot,
+                                                std::string_view query, size_t limit) const {
+    std::lock_guard<std::mutex> lock(searchMutex);
+    if (!snapshot) return {};
+    buildIndexLocked(snapshot);
+    TraceSpan span("search.query");
+    return searchIndex.search(query, limit);
+}
+
+void TechniqueManager::prepareSearch(const std::shared_ptr<const ICatalog>& snapshot) const {
+    std::lock_guard<std::mutex> lock(searchMutex);
+    if (snapshot) buildIndexLocked(snapshot);
+}
+
+void TechniqueManager::buildIndexLocked(const std::shared_ptr<const ICatalog>& snapshot) const {
+    if (indexedCatalog == snapshot) return;
+    TraceSpan build("search.buildIndex");
+    searchIndex.build(*snapshot);
+    indexedCatalog = snapshot;
+}
+
+bool TechniqueManager::reloadFromJson(const std::string& filename, CatalogDiff* diff, const LiveCatalog* baseline) {
+    TraceSpan span("catalog.reloadFromJson");
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    auto current = catalog.load();
+    const LiveCatalog* previous = dynamic_cast<const LiveCatalog*>(current.get());
+    auto live = std::make_shared<LiveCatalog>();
+    if (!live->load(filename, previous ? previous : baseline, diff)) return false;
+    catalog.store(std::move(live));
+    return true;
+}
+
+std::shared_ptr<const ICatalog> TechniqueManager::getCatalog() const {
+    return catalog.load();
+}
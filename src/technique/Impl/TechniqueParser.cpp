@@ -0,0 +1,115 @@
+#include "../Header/TechniqueParser.h"
+#include "../Header/TechniqueManager.h"
+#include "Hash.h"
+#include <algorithm>
+#include <cctype>
+#include <nlohmann/json.hpp>
+
+namespace {
+    // Sections whose key names no standard sort after all the others.
+    constexpr int UNNUMBERED_SECTION = 10000;
+
+    int sectionYear(std::string_view key) {
+        int year = TechniqueParser::standardYear(key);
+        return year ? year : UNNUMBERED_SECTION;
+    }
+}
+
+int TechniqueParser::standardYear(std::string_view text) {
+    size_t begin = 0;
+    while (begin < text.size() && !std::isdigit(static_cast<unsigned char>(text[begin]))) ++begin;
+    if (begin == text.size()) return 0;
+    if (begin + 1 < text.size() && std::isalpha(static_cast<unsigned char>(text[begin + 1]))) {
+        // Provisional names of unfinished standards: 0x, 1y, 1z, then 2a, 2b, 2c, ...
+        char decade = text[begin];
+        int letter = std::tolower(static_cast<unsigned char>(text[begin + 1]));
+        if (decade == '0' && letter == 'x') return 2011;
+        if (decade == '1' && letter >= 'y') return 2014 + 3 * (letter - 'y');
+        if (decade == '2') return 2020 + 3 * (letter - 'a');
+        return 0;
+    }
+    size_t end = begin;
+    int value = 0;
+    while (end < text.size() && std::isdigit(static_cast<unsigned char>(text[end])) && end - begin < 4) {
+        value = value * 10 + (text[end] - '0');
+        ++end;
+    }
+    if (end - begin <= 2) return value >= 70 ? 1900 + value : 2000 + value;
+    return value;
+}
+
+Technique TechniqueParser::fromJson(const nlohmann::json& item, const std::string& cpp_version) {
+    std::string name = item.value("name", "");
+    std::string definition = item.value("definition", "");
+    std::string usage;
+    if (item.contains("primary_use_cases")) {
+        usage = "- " + TechniqueManager::joinVector(item["primary_use_cases"].get<std::vector<std::string>>(), "\n- ");
+    }
+    std::string syntax = syntaxText(item);
+    std::string demo_code;
+    std::string expected_output;
+    if (item.contains("complete_demo")) {
+        if (item["complete_demo"].contains("code"))
+            demo_code = item["complete_demo"]["code"].get<std::string>();
+        if (item["complete_demo"].contains("expected_output"))
+            expected_output = item["complete_demo"]["expected_output"].get<std::string>();
+    }
+    std::string notes = notesText(item);
+    std::string demo_note;
+    std::vector<std::string> use_cases;
+    if (item.contains("primary_use_cases")) use_cases = item["primary_use_cases"].get<std::vector<std::string>>();
+    std::vector<std::string> best_practices;
+    if (item.contains("best_practices")) best_practices = item["best_practices"].get<std::vector<std::string>>();
+    std::vector<std::string> advantages;
+    if (item.contains("advantages")) advantages = item["advantages"].get<std::vector<std::string>>();
+    return Technique(
+        std::move(name), std::move(definition), std::move(usage), std::move(syntax),
+        std::move(demo_code), cpp_version, std::move(notes), std::move(demo_note),
+        std::move(use_cases), std::move(best_practices), std::move(advantages),
+        std::move(expected_output)
+    );
+}
+
+uint64_t TechniqueParser::contentHash(const nlohmann::json& item, const std::string& cpp_version) {
+    return Hash::fnv1a64(item.dump(), Hash::fnv1a64(cpp_version));
+}
+
+std::string TechniqueParser::syntaxText(const nlohmann::json& item) {
+    std::string syntax;
+    if (item.contains("syntax")) {
+        if (item["syntax"].is_object()) {
+            for (auto it = item["syntax"].begin(); it != item["syntax"].end(); ++it) {
+                syntax += it.key() + ": " + it.value().get<std::string>() + "\n";
+            }
+        } else if (item["syntax"].is_string()) {
+            syntax = item["syntax"].get<std::string>();
+        }
+    }
+    return syntax;
+}
+
+std::string TechniqueParser::notesText(const nlohmann::json& item) {
+    std::string notes;
+    if (item.contains("category")) notes += "Category: " + item["category"].get<std::string>() + "\n";
+    if (item.contains("complexity_level")) notes += "Level: " + item["complexity_level"].get<std::string>() + "\n";
+    if (item.contains("key_improvements")) notes += "Improvements: " + item["key_improvements"].get<std::string>() + "\n";
+    return notes;
+}
+
+bool TechniqueParser::sectionBefore(std::string_view a, std::string_view b) {
+    int yearA = sectionYear(a);
+    int yearB = sectionYear(b);
+    return yearA != yearB ? yearA < yearB : a < b;
+}
+
+std::vector<std::string> TechniqueParser::sectionKeys(const nlohmann::json& featuresRoot) {
+    std::vector<std::string> keys;
+    if (!featuresRoot.is_object()) return keys;
+    for (auto it = featuresRoot.begin(); it != featuresRoot.end(); ++it) {
+        if (it.value().is_object() && it.value().contains("features") && it.value()["features"].is_array()) {
+            keys.push_back(it.key());
+        }
+    }
+    std::sort(keys.begin(), keys.end(), sectionBefore);
+    return keys;
+}
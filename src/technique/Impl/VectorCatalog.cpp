@@ -0,0 +1,57 @@
+#include "../Header/VectorCatalog.h"
+
+namespace {
+    // Strings short enough for the small-string buffer live inside the object.
+    void addString(CatalogMemoryUsage& usage, const std::string& text) {
+        const char* object = reinterpret_cast<const char*>(&text);
+        if (text.data() >= object && text.data() < object + sizeof(text)) return;
+        usage.bytes += text.capacity() + 1;
+        ++usage.allocations;
+    }
+
+    void addList(CatalogMemoryUsage& usage, const std::vector<std::string>& list) {
+        if (list.capacity() > 0) {
+            usage.bytes += list.capacity() * sizeof(std::string);
+            ++usage.allocations;
+        }
+        for (const auto& item : list) addString(usage, item);
+    }
+}
+
+VectorCatalog::VectorCatalog(std::vector<Technique> techniques)
+    : techniques(std::move(techniques)) {}
+
+size_t VectorCatalog::size() const {
+    return techniques.size();
+}
+
+std::string_view VectorCatalog::name(size_t index) const {
+    return techniques[index].getName();
+}
+
+std::string_view VectorCatalog::cppVersion(size_t index) const {
+    return techniques[index].getCppVersion();
+}
+
+const Technique& VectorCatalog::technique(size_t index) const {
+    return techniques[index];
+}
+
+CatalogMemoryUsage VectorCatalog::memoryUsage() const {
+    CatalogMemoryUsage usage;
+    if (techniques.capacity() > 0) {
+        usage.bytes += techniques.capacity() * sizeof(Technique);
+        ++usage.allocations;
+    }
+    for (const auto& tech : techniques) {
+        for (const std::string* text : {&tech.getName(), &tech.getDefinition(), &tech.getUsage(),
+                                        &tech.getSyntax(), &tech.getDemoCode(), &tech.getCppVersion(),
+                                        &tech.getNotes(), &tech.getDemoNote(), &tech.getExpectedOutput()}) {
+            addString(usage, *text);
+        }
+        addList(usage, tech.getUseCases());
+        addList(usage, tech.getBestPractices());
+        addList(usage, tech.getAdvantages());
+    }
+    return usage;
+}
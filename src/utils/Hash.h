@@ -0,0 +1,36 @@
+#ifndef HASH_H
+#define HASH_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class Hash {
+public:
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    // FNV-1a; pass the previous result as seed to hash several pieces in sequence.
+    static uint64_t fnv1a64(std::string_view data, uint64_t seed = FNV_OFFSET);
+    static std::string toHex(uint64_t value);
+
+    // SHA-256 (FIPS 180-4), for keys where a collision would be a wrong
+    // result rather than a cache miss. Feed pieces with update(), then call
+    // hex() once.
+    class Sha256 {
+    private:
+        std::array<uint32_t, 8> state;
+        std::array<unsigned char, 64> block;
+        size_t blockSize = 0;
+        uint64_t totalBytes = 0;
+
+        void compress(const unsigned char* data);
+    public:
+        Sha256();
+        Sha256& update(std::string_view data);
+        std::string hex();
+    };
+};
+
+#endif // HASH_H
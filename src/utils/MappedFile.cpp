@@ -0,0 +1,88 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+namespace {
+    long long modificationNs(const struct stat& st) {
+        return static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), length(std::exchange(other.length, 0)),
+      fd(std::exchange(other.fd, -1)), modifiedNs(other.modifiedNs) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data = std::exchange(other.data, nullptr);
+        length = std::exchange(other.length, 0);
+        fd = std::exchange(other.fd, -1);
+        modifiedNs = other.modifiedNs;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+    int file = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) return false;
+    struct stat st;
+    if (fstat(file, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(file);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+        // mmap rejects empty mappings; an empty file is still a valid open.
+        data = "";
+    } else {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(file);
+            return false;
+        }
+        data = static_cast<const char*>(mapping);
+    }
+    length = size;
+    fd = file;
+    modifiedNs = modificationNs(st);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data && length > 0) munmap(const_cast<char*>(data), length);
+    if (fd >= 0) ::close(fd);
+    data = nullptr;
+    length = 0;
+    fd = -1;
+}
+
+bool MappedFile::unchanged() const {
+    struct stat st;
+    return fd >= 0 && fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == length &&
+           modificationNs(st) == modifiedNs;
+}
+
+bool MappedFile::isOpen() const {
+    return data != nullptr;
+}
+
+const char* MappedFile::begin() const {
+    return data;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+std::string_view MappedFile::view() const {
+    return {data ? data : "", length};
+}
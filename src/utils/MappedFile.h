@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file. Pages are loaded on demand by the
+// kernel and shared with every other process mapping the same file, so an
+// in-place rewrite shows through and a truncation makes the lost pages fault
+// (SIGBUS). Writers should replace the file by rename; readers that cannot rely
+// on that check unchanged() before touching the bytes.
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+    int fd = -1;                 // kept open so unchanged() sees this inode
+    long long modifiedNs = 0;    // st_mtim at open()
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+    // False once the file was truncated or written since open(). A rename
+    // over the path does not count: the mapping keeps the old inode.
+    bool unchanged() const;
+    const char* begin() const;
+    size_t size() const;
+    std::string_view view() const;
+};
+
+#endif // MAPPEDFILE_H
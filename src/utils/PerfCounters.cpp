@@ -0,0 +1,64 @@
+#include "PerfCounters.h"
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+bool PerfCounters::attach(pid_t pid) {
+#ifdef __linux__
+    close();
+    const uint64_t configs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < 3; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.enable_on_exec = 1;
+        attr.inherit = 1;
+        // User space only, so it works with the default perf_event_paranoid.
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, pid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        if (fds[i] < 0) {
+            close();
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)pid;
+    return false;
+#endif
+}
+
+HardwareCounters PerfCounters::read() const {
+    HardwareCounters counters;
+#ifdef __linux__
+    uint64_t values[3] = {};
+    for (int i = 0; i < 3; ++i) {
+        if (fds[i] < 0 || ::read(fds[i], &values[i], sizeof(values[i])) != sizeof(values[i])) return counters;
+    }
+    counters.available = true;
+    counters.cycles = values[0];
+    counters.instructions = values[1];
+    counters.cacheMisses = values[2];
+#endif
+    return counters;
+}
+
+void PerfCounters::close() {
+#ifdef __linux__
+    for (int& fd : fds) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+#endif
+}
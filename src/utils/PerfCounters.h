@@ -0,0 +1,31 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+#include <cstdint>
+#include <sys/types.h>
+
+struct HardwareCounters {
+    bool available = false;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cacheMisses = 0;
+};
+
+// Hardware counters (cycles, instructions, cache misses) of one child process
+// via perf_event_open. attach() must run before the child execs: counting is
+// enabled by the exec itself, so the fork/exec glue is not measured. Fails
+// quietly where perf events are not permitted or not virtualized.
+class PerfCounters {
+private:
+    int fds[3] = {-1, -1, -1};
+public:
+    PerfCounters() = default;
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool attach(pid_t pid);
+    HardwareCounters read() const;
+    void close();
+};
+
+#endif // PERFCOUNTERS_H
@@ -0,0 +1,245 @@
+#include "Process.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    void closeFd(int& fd) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    bool makePipe(int fds[2]) {
+        return pipe2(fds, O_CLOEXEC) == 0;
+    }
+
+    // A pollable handle that becomes readable when the child exits (Linux 5.3+).
+    int openPidFd(pid_t pid) {
+#ifdef SYS_pidfd_open
+        return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+        (void)pid;
+        return -1;
+#endif
+    }
+
+    void killGroup(pid_t pid) {
+        kill(-pid, SIGKILL);
+        kill(pid, SIGKILL);
+    }
+
+    int remainingMs(Clock::time_point deadline, bool hasDeadline) {
+        if (!hasDeadline) return -1;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        return left > 0 ? static_cast<int>(left) : 0;
+    }
+
+    // Only async-signal-safe calls are allowed between fork and exec: the
+    // parent may be multithreaded (e.g. --verify-all).
+    [[noreturn]] void execChild(const char* path, char* const* argv, int in, int out, int err,
+                                const int sync[2], const ProcessOptions& options) {
+        setpgid(0, 0);
+        // Blocked signals survive exec; a server that blocks SIGINT for its
+        // signalfd must not hand that mask down to demos.
+        sigset_t none;
+        sigemptyset(&none);
+        sigprocmask(SIG_SETMASK, &none, nullptr);
+        // Ignored dispositions survive exec too, and run() ignores SIGPIPE
+        // process-wide; demos must die on a broken pipe like anywhere else.
+        signal(SIGPIPE, SIG_DFL);
+        if (sync[0] >= 0) {
+            // Hold the exec until the parent has attached its perf counters.
+            close(sync[1]);
+            char ready;
+            while (read(sync[0], &ready, 1) < 0 && errno == EINTR) {}
+        }
+        if (dup2(in, STDIN_FILENO) < 0 || dup2(out, STDOUT_FILENO) < 0 || dup2(err, STDERR_FILENO) < 0) _exit(127);
+        if (!options.workingDirectory.empty() && chdir(options.workingDirectory.c_str()) != 0) _exit(127);
+        if (options.cpuSeconds > 0) {
+            struct rlimit limit = {options.cpuSeconds, options.cpuSeconds + 1};
+            setrlimit(RLIMIT_CPU, &limit);
+        }
+        if (options.memoryBytes > 0) {
+            struct rlimit limit = {options.memoryBytes, options.memoryBytes};
+            setrlimit(RLIMIT_AS, &limit);
+        }
+        execve(path, argv, environ);
+        _exit(127);
+    }
+}
+
+std::string Process::findExecutable(const std::string& name) {
+    if (name.find('/') != std::string::npos) return name;
+    const char* env = std::getenv("PATH");
+    std::istringstream dirs(env ? env : "/usr/bin:/bin");
+    std::string dir;
+    while (std::getline(dirs, dir, ':')) {
+        std::string candidate = (dir.empty() ? "." : dir) + "/" + name;
+        if (access(candidate.c_str(), X_OK) == 0) return candidate;
+    }
+    return {};
+}
+
+ProcessResult Process::run(const std::vector<std::string>& argv, const ProcessOptions& options) {
+    // Writing to a child that already exited must be an EPIPE, not a fatal signal.
+    static std::once_flag ignoreSigpipe;
+    std::call_once(ignoreSigpipe, [] { std::signal(SIGPIPE, SIG_IGN); });
+
+    ProcessResult result;
+    if (argv.empty()) return result;
+    std::string path = findExecutable(argv[0]);
+    if (path.empty()) {
+        result.err = argv[0] + ": command not found\n";
+        return result;
+    }
+    std::vector<char*> args;
+    for (const auto& arg : argv) args.push_back(const_cast<char*>(arg.c_str()));
+    args.push_back(nullptr);
+
+    int inPipe[2], outPipe[2], errPipe[2];
+    if (!makePipe(inPipe)) return result;
+    if (!makePipe(outPipe)) {
+        close(inPipe[0]); close(inPipe[1]);
+        return result;
+    }
+    if (!makePipe(errPipe)) {
+        close(inPipe[0]); close(inPipe[1]); close(outPipe[0]); close(outPipe[1]);
+        return result;
+    }
+
+    int syncPipe[2] = {-1, -1};
+    if (options.hardwareCounters && !makePipe(syncPipe)) syncPipe[0] = syncPipe[1] = -1;
+
+    auto start = Clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        execChild(path.c_str(), args.data(), inPipe[0], outPipe[1], errPipe[1], syncPipe, options);
+    }
+    close(inPipe[0]);
+    close(outPipe[1]);
+    close(errPipe[1]);
+    closeFd(syncPipe[0]);
+    int inFd = inPipe[1], outFd = outPipe[0], errFd = errPipe[0];
+    PerfCounters counters;
+    if (pid > 0 && syncPipe[1] >= 0) {
+        counters.attach(pid);
+        char ready = 1;
+        while (write(syncPipe[1], &ready, 1) < 0 && errno == EINTR) {}
+    }
+    closeFd(syncPipe[1]);
+    if (pid < 0) {
+        closeFd(inFd); closeFd(outFd); closeFd(errFd);
+        return result;
+    }
+    result.started = true;
+    setpgid(pid, pid);  // also done in the child; whichever runs first wins
+
+    bool hasDeadline = options.timeoutSeconds > 0;
+    auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+                                std::chrono::duration<double>(options.timeoutSeconds));
+    size_t written = 0;
+    if (options.input.empty()) closeFd(inFd);
+    else fcntl(inFd, F_SETFL, O_NONBLOCK);
+
+    char buffer[65536];
+    while ((outFd >= 0 || errFd >= 0 || inFd >= 0) && !result.truncated) {
+        struct pollfd fds[3];
+        int count = 0;
+        if (inFd >= 0) fds[count++] = {inFd, POLLOUT, 0};
+        if (outFd >= 0) fds[count++] = {outFd, POLLIN, 0};
+        if (errFd >= 0) fds[count++] = {errFd, POLLIN, 0};
+        int timeout = remainingMs(deadline, hasDeadline);
+        if (hasDeadline && timeout == 0) {
+            result.timedOut = true;
+            break;
+        }
+        int ready = poll(fds, count, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (fds[i].revents == 0) continue;
+            if (fds[i].fd == inFd) {
+                ssize_t n = write(inFd, options.input.data() + written, options.input.size() - written);
+                if (n > 0) written += static_cast<size_t>(n);
+                if (n < 0 && errno != EAGAIN && errno != EINTR) closeFd(inFd);
+                else if (written == options.input.size()) closeFd(inFd);
+                continue;
+            }
+            int& fd = (fds[i].fd == outFd) ? outFd : errFd;
+            std::string& sink = (fds[i].fd == outFd) ? result.out : result.err;
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                size_t keep = static_cast<size_t>(n);
+                if (options.outputLimit > 0 && sink.size() + keep > options.outputLimit) {
+                    keep = options.outputLimit - sink.size();
+                    result.truncated = true;
+                }
+                sink.append(buffer, keep);
+            } else if (n == 0 || (errno != EINTR && errno != EAGAIN)) closeFd(fd);
+        }
+    }
+
+    // The pipes can close before the child exits (or stay open after it
+    // forked); keep honouring the deadline while waiting for it.
+    int status = 0;
+    struct rusage usage = {};
+    bool reaped = false;
+    if (hasDeadline && !result.timedOut && !result.truncated) {
+        int pidFd = openPidFd(pid);
+        int ready = -1;
+        if (pidFd >= 0) {
+            struct pollfd exited = {pidFd, POLLIN, 0};
+            while ((ready = poll(&exited, 1, remainingMs(deadline, true))) < 0 && errno == EINTR) {}
+            closeFd(pidFd);
+            if (ready == 0) result.timedOut = true;
+        }
+        // No pidfd (kernel before 5.3) or poll failed: check on the child with
+        // a backoff until it exits or the deadline passes.
+        for (int sleepMs = 1; ready < 0 && !result.timedOut; sleepMs = std::min(sleepMs * 2, 20)) {
+            pid_t done = wait4(pid, &status, WNOHANG, &usage);
+            if (done == pid) {
+                reaped = true;
+                break;
+            }
+            if (done < 0 && errno != EINTR) break;
+            int left = remainingMs(deadline, true);
+            if (left == 0) result.timedOut = true;
+            else std::this_thread::sleep_for(std::chrono::milliseconds(std::min(sleepMs, left)));
+        }
+    }
+    if (result.timedOut || result.truncated) killGroup(pid);
+    if (!reaped) {
+        while (wait4(pid, &status, 0, &usage) < 0 && errno == EINTR) {}
+    }
+    closeFd(inFd);
+    closeFd(outFd);
+    closeFd(errFd);
+
+    result.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.userSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+    result.systemSeconds = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    result.maxRssKb = usage.ru_maxrss;
+    result.counters = counters.read();
+    if (WIFEXITED(status)) result.exitCode = WEXITSTATUS(status);
+    if (WIFSIGNALED(status)) result.termSignal = WTERMSIG(status);
+    return result;
+}
@@ -0,0 +1,44 @@
+#ifndef PROCESS_H
+#define PROCESS_H
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "PerfCounters.h"
+
+struct ProcessOptions {
+    std::string input;              // written to the child's stdin, then closed
+    double timeoutSeconds = 0.0;    // wall clock; 0 = no limit
+    rlim_t cpuSeconds = 0;          // RLIMIT_CPU; 0 = inherit
+    rlim_t memoryBytes = 0;         // RLIMIT_AS; 0 = inherit
+    std::string workingDirectory;
+    bool hardwareCounters = false;  // collect ProcessResult::counters if permitted
+    size_t outputLimit = 16 << 20;  // bytes kept per stream; the child is killed past it; 0 = no limit
+};
+
+struct ProcessResult {
+    bool started = false;
+    int exitCode = -1;              // valid when the child exited normally
+    int termSignal = 0;             // signal that killed the child, if any
+    bool timedOut = false;
+    bool truncated = false;         // out or err hit outputLimit
+    std::string out;
+    std::string err;
+    double wallSeconds = 0.0;
+    double userSeconds = 0.0;       // CPU time of the child, from wait4
+    double systemSeconds = 0.0;
+    long maxRssKb = 0;
+    HardwareCounters counters;
+
+    bool succeeded() const { return started && termSignal == 0 && exitCode == 0; }
+};
+
+// Runs a program directly (no shell) with stdin/stdout/stderr connected to
+// pipes. The child gets its own process group so a timeout kills everything it
+// spawned as well.
+class Process {
+public:
+    static ProcessResult run(const std::vector<std::string>& argv, const ProcessOptions& options = {});
+    static std::string findExecutable(const std::string& name);
+};
+
+#endif // PROCESS_H
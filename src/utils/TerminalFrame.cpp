@@ -0,0 +1,95 @@
+#include "TerminalFrame.h"
+#include "Trace.h"
+#ifdef _WIN32
+#include <iostream>
+#else
+#include <cerrno>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr size_t DEFAULT_ROWS = 24;
+    constexpr size_t DEFAULT_COLUMNS = 80;
+    constexpr size_t TAB_WIDTH = 4;
+}
+
+TerminalFrame::TerminalFrame(int fd) : fd(fd) {}
+
+void TerminalFrame::begin() {
+    // clear() keeps the capacity, so steady-state redraws do not allocate.
+    buffer.clear();
+    buffer += "\033[H";
+}
+
+bool TerminalFrame::present() {
+    TraceSpan span("terminal.present");
+    buffer += "\033[J";
+    Trace::counter("terminal.bytes", static_cast<int64_t>(buffer.size()));
+#ifdef _WIN32
+    std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::cout.flush();
+    return static_cast<bool>(std::cout);
+#else
+    const char* data = buffer.data();
+    size_t left = buffer.size();
+    while (left > 0) {
+        ssize_t written = ::write(fd, data, left);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+    return true;
+#endif
+}
+
+const std::string& TerminalFrame::contents() const {
+    return buffer;
+}
+
+TerminalFrame& TerminalFrame::operator<<(std::string_view text) {
+    buffer += text;
+    return *this;
+}
+
+size_t TerminalFrame::rows() const {
+#ifndef _WIN32
+    winsize size{};
+    if (ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) return size.ws_row;
+#endif
+    return DEFAULT_ROWS;
+}
+
+size_t TerminalFrame::columns() const {
+#ifndef _WIN32
+    winsize size{};
+    if (ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0) return size.ws_col;
+#endif
+    return DEFAULT_COLUMNS;
+}
+
+size_t TerminalFrame::displayWidth(std::string_view text) {
+    size_t width = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '\033' && i + 1 < text.size() && text[i + 1] == '[') {
+            // CSI sequence: parameters up to a final byte in 0x40-0x7E.
+            i += 2;
+            while (i < text.size() && (text[i] < 0x40 || text[i] > 0x7E)) ++i;
+        } else if (c == '\t') {
+            width += TAB_WIDTH;
+        } else if ((c & 0xC0) != 0x80) {
+            ++width;
+        }
+    }
+    return width;
+}
+
+size_t TerminalFrame::rowsFor(std::string_view text, size_t columns) {
+    size_t width = displayWidth(text);
+    if (width == 0 || columns == 0) return 1;
+    return (width + columns - 1) / columns;
+}
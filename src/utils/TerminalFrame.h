@@ -0,0 +1,54 @@
+#ifndef TERMINALFRAME_H
+#define TERMINALFRAME_H
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <string_view>
+
+// One screen worth of output, assembled in a reusable buffer and sent with a
+// single write. Frames overwrite the previous one in place (cursor home, erase
+// to end of each line, erase below) instead of clearing the screen first, so
+// slow or remote terminals never show a blank screen between redraws.
+class TerminalFrame {
+private:
+    std::string buffer;
+    int fd;
+public:
+    // Ends a line and erases whatever the previous frame left after it.
+    static constexpr std::string_view EOL = "\033[K\n";
+
+    explicit TerminalFrame(int fd = 1);
+    void begin();
+    bool present();
+    const std::string& contents() const;
+
+    TerminalFrame& operator<<(std::string_view text);
+    template <std::integral T>
+    TerminalFrame& operator<<(T value) {
+        char digits[24];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer.append(digits, end);
+        return *this;
+    }
+
+    // Terminal size, falling back to 80x24 when not attached to a terminal.
+    size_t rows() const;
+    size_t columns() const;
+    // Printed width of text, ignoring escape sequences and UTF-8 continuation bytes.
+    static size_t displayWidth(std::string_view text);
+    // Screen rows text occupies once the terminal wraps it.
+    static size_t rowsFor(std::string_view text, size_t columns);
+    // Calls fn with each '\n'-separated line of text. Frame lines must not
+    // contain newlines: EOL and rowsFor() work one line at a time.
+    template <typename Fn>
+    static void forEachLine(std::string_view text, Fn&& fn) {
+        while (!text.empty()) {
+            size_t end = text.find('\n');
+            fn(text.substr(0, end));
+            if (end == std::string_view::npos) break;
+            text.remove_prefix(end + 1);
+        }
+    }
+};
+
+#endif // TERMINALFRAME_H
@@ -0,0 +1,112 @@
+#include "ThreadPool.h"
+
+namespace {
+    // Pool and worker index of the current thread; null for outside threads.
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local size_t currentIndex = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) threadCount = defaultThreadCount();
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+size_t ThreadPool::defaultThreadCount() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores == 0 ? 1 : cores;
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+void ThreadPool::submit(Task task) {
+    // Tasks spawned from a worker stay on that worker's deque (better locality);
+    // outside submissions are spread round-robin.
+    size_t index = (currentPool == this)
+        ? currentIndex
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    pending.fetch_add(1, std::memory_order_acq_rel);
+    queued.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Pairs with the predicate check in workerLoop so the wakeup is not lost.
+        std::lock_guard<std::mutex> lock(stateMutex);
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+bool ThreadPool::popLocal(size_t index, Task& task) {
+    auto& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task& task) {
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        auto& victim = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            try {
+                task();
+            } catch (...) {
+                // A failing task must not take the worker (and waitIdle) down with it.
+            }
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(stateMutex);
+        if (stopping) return;
+        // Re-check under the state lock so a submit between the failed steal
+        // and the wait cannot be missed.
+        workAvailable.wait(lock, [this] {
+            return stopping || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool: each worker owns a deque, pops its own work
+// LIFO and steals FIFO from the other workers when it runs dry.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+    void waitIdle();
+    size_t size() const;
+
+    static size_t defaultThreadCount();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    std::atomic<size_t> pending{0};  // submitted but not yet finished
+    std::atomic<size_t> queued{0};   // sitting in a deque, not yet picked up
+    std::atomic<size_t> nextQueue{0};
+    bool stopping = false;
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,226 @@
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct TraceEvent {
+        const char* name;
+        uint64_t start;
+        uint64_t duration;
+        int64_t value;
+        bool counter;
+    };
+
+    // Written only by its owning thread; head is published with release so a
+    // reader that acquires it sees every event before it.
+    struct ThreadBuffer {
+        uint32_t thread;
+        size_t capacity;
+        std::unique_ptr<TraceEvent[]> events;
+        std::atomic<uint64_t> head{0};
+    };
+
+    // Buffers outlive their threads (pool workers are gone by export time).
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        size_t capacity = Trace::DEFAULT_CAPACITY;
+        Clock::time_point origin = Clock::now();
+        bool started = false;
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    thread_local ThreadBuffer* localBuffer = nullptr;
+
+    ThreadBuffer& threadBuffer() {
+        if (!localBuffer) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->thread = static_cast<uint32_t>(reg.buffers.size());
+            buffer->capacity = reg.capacity;
+            buffer->events = std::make_unique<TraceEvent[]>(reg.capacity);
+            localBuffer = buffer.get();
+            reg.buffers.push_back(std::move(buffer));
+        }
+        return *localBuffer;
+    }
+
+    void record(const TraceEvent& event) {
+        ThreadBuffer& buffer = threadBuffer();
+        uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        buffer.events[head % buffer.capacity] = event;
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    // Calls visit(thread, event) for every retained event; returns how many were overwritten.
+    template <typename Visit>
+    uint64_t forEachEvent(Visit visit) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        uint64_t dropped = 0;
+        for (const auto& buffer : reg.buffers) {
+            uint64_t head = buffer->head.load(std::memory_order_acquire);
+            uint64_t kept = std::min<uint64_t>(head, buffer->capacity);
+            dropped += head - kept;
+            for (uint64_t i = head - kept; i < head; ++i) visit(buffer->thread, buffer->events[i % buffer->capacity]);
+        }
+        return dropped;
+    }
+
+    double milliseconds(uint64_t ns) {
+        return static_cast<double>(ns) / 1e6;
+    }
+}
+
+void Trace::enable(size_t eventsPerThread) {
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.started) {
+            reg.started = true;
+            reg.capacity = std::max<size_t>(eventsPerThread, 1);
+            reg.origin = Clock::now();
+        }
+    }
+    active.store(true, std::memory_order_relaxed);
+}
+
+void Trace::disable() {
+    active.store(false, std::memory_order_relaxed);
+}
+
+uint64_t Trace::now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - registry().origin).count());
+}
+
+void Trace::span(const char* name, uint64_t start, uint64_t end) {
+    if (!enabled()) return;
+    record({name, start, end > start ? end - start : 0, 0, false});
+}
+
+void Trace::counter(const char* name, int64_t value) {
+    if (!enabled()) return;
+    record({name, now(), 0, value, true});
+}
+
+bool Trace::writeChromeTrace(const std::string& path, std::string& errors) {
+    std::ofstream out(path);
+    if (!out) {
+        errors += path + ": cannot write trace\n";
+        return false;
+    }
+    // One event per line keeps the file streamable and diffable.
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    forEachEvent([&](uint32_t thread, const TraceEvent& event) {
+        nlohmann::json entry = {
+            {"name", event.name},
+            {"ph", event.counter ? "C" : "X"},
+            {"ts", static_cast<double>(event.start) / 1e3},
+            {"pid", 1},
+            {"tid", thread},
+        };
+        if (event.counter) entry["args"] = {{"value", event.value}};
+        else entry["dur"] = static_cast<double>(event.duration) / 1e3;
+        out << (first ? "" : ",\n") << entry.dump();
+        first = false;
+    });
+    out << "\n]}\n";
+    if (!out) {
+        errors += path + ": write failed\n";
+        return false;
+    }
+    return true;
+}
+
+void Trace::writeStats(std::ostream& out) {
+    struct SpanStats {
+        std::vector<uint64_t> durations;
+        uint64_t total = 0;
+    };
+    struct CounterStats {
+        size_t count = 0;
+        int64_t sum = 0, min = 0, max = 0;
+    };
+    // Keyed by text: the same literal may have several addresses across translation units.
+    std::map<std::string_view, SpanStats> spans;
+    std::map<std::string_view, CounterStats> counters;
+    size_t events = 0;
+    uint64_t dropped = forEachEvent([&](uint32_t, const TraceEvent& event) {
+        ++events;
+        if (event.counter) {
+            CounterStats& stats = counters[event.name];
+            stats.min = stats.count ? std::min(stats.min, event.value) : event.value;
+            stats.max = stats.count ? std::max(stats.max, event.value) : event.value;
+            stats.sum += event.value;
+            ++stats.count;
+        } else {
+            SpanStats& stats = spans[event.name];
+            stats.durations.push_back(event.duration);
+            stats.total += event.duration;
+        }
+    });
+
+    out << "Trace summary: " << events << " events";
+    if (dropped) out << " (" << dropped << " oldest overwritten)";
+    out << "\n";
+    if (!spans.empty()) {
+        std::vector<std::pair<std::string_view, SpanStats*>> order;
+        for (auto& [name, stats] : spans) order.emplace_back(name, &stats);
+        std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.second->total > b.second->total; });
+        out << std::left << std::setw(32) << "span" << std::right << std::setw(8) << "count" << std::setw(12) << "total ms"
+            << std::setw(12) << "mean ms" << std::setw(12) << "p95 ms" << std::setw(12) << "max ms" << "\n";
+        out << std::fixed << std::setprecision(3);
+        for (auto& [name, stats] : order) {
+            std::vector<uint64_t>& durations = stats->durations;
+            std::sort(durations.begin(), durations.end());
+            size_t p95 = std::min(durations.size() - 1, durations.size() * 95 / 100);
+            out << std::left << std::setw(32) << name << std::right << std::setw(8) << durations.size()
+                << std::setw(12) << milliseconds(stats->total)
+                << std::setw(12) << milliseconds(stats->total / durations.size())
+                << std::setw(12) << milliseconds(durations[p95])
+                << std::setw(12) << milliseconds(durations.back()) << "\n";
+        }
+        out << std::defaultfloat;
+    }
+    if (!counters.empty()) {
+        out << std::left << std::setw(32) << "counter" << std::right << std::setw(8) << "count" << std::setw(14) << "sum"
+            << std::setw(12) << "min" << std::setw(12) << "max" << "\n";
+        for (const auto& [name, stats] : counters) {
+            out << std::left << std::setw(32) << name << std::right << std::setw(8) << stats.count << std::setw(14) << stats.sum
+                << std::setw(12) << stats.min << std::setw(12) << stats.max << "\n";
+        }
+    }
+}
+
+TraceSession::TraceSession(std::string chromePath, bool stats) : chromePath(std::move(chromePath)), stats(stats) {
+    if (!this->chromePath.empty() || stats) Trace::enable();
+}
+
+TraceSession::~TraceSession() {
+    if (!Trace::enabled()) return;
+    Trace::disable();
+    std::string errors;
+    if (!chromePath.empty() && Trace::writeChromeTrace(chromePath, errors)) {
+        std::cerr << "Trace written to " << chromePath << "\n";
+    }
+    std::cerr << errors;
+    if (stats) Trace::writeStats(std::cerr);
+}
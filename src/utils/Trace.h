@@ -0,0 +1,71 @@
+#ifndef TRACE_H
+#define TRACE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Low-overhead instrumentation: timed spans and counter samples recorded into
+// per-thread ring buffers. Each thread appends to its own buffer without
+// locks (the buffer is registered once, on that thread's first event); when a
+// buffer is full the oldest events are overwritten. While tracing is off every
+// call reduces to one relaxed atomic load.
+//
+// Event names are not copied: pass string literals. Export and the summary
+// read every buffer, so call them once the traced work has finished.
+class Trace {
+private:
+    static inline std::atomic<bool> active{false};
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;  // events per thread
+
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+    // The first call fixes the time origin and the per-thread capacity.
+    static void enable(size_t eventsPerThread = DEFAULT_CAPACITY);
+    static void disable();
+    // Nanoseconds since enable().
+    static uint64_t now();
+
+    static void span(const char* name, uint64_t start, uint64_t end);
+    static void counter(const char* name, int64_t value);
+
+    // Chrome trace_event JSON, for chrome://tracing or ui.perfetto.dev.
+    static bool writeChromeTrace(const std::string& path, std::string& errors);
+    // Per-name totals: count/total/mean/p95/max for spans, count/sum/min/max for counters.
+    static void writeStats(std::ostream& out);
+};
+
+// Records the time between construction and destruction (or end()) as one span.
+class TraceSpan {
+private:
+    const char* name;
+    uint64_t start = 0;
+public:
+    explicit TraceSpan(const char* name) : name(Trace::enabled() ? name : nullptr) {
+        if (this->name) start = Trace::now();
+    }
+    ~TraceSpan() { end(); }
+    // Closes the span early, e.g. before waiting for user input.
+    void end() {
+        if (name) Trace::span(name, start, Trace::now());
+        name = nullptr;
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+// Turns tracing on for its lifetime when a trace file or a summary was
+// requested, and writes them (the summary to stderr) when destroyed.
+class TraceSession {
+private:
+    std::string chromePath;
+    bool stats;
+public:
+    TraceSession(std::string chromePath, bool stats);
+    ~TraceSession();
+    TraceSession(const TraceSession&) = delete;
+    TraceSession& operator=(const TraceSession&) = delete;
+};
+
+#endif // TRACE_H
@@ -0,0 +1,90 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// Shared helpers for the CTest executables. Each test is a plain main() that
+// runs its CHECKs and returns TestSupport::result(): non-zero if any failed.
+namespace TestSupport {
+    inline int failures = 0;
+
+    inline int result() {
+        if (failures) std::cerr << failures << " check(s) failed\n";
+        return failures ? 1 : 0;
+    }
+
+    // A fresh directory under the system temp directory, removed on destruction.
+    class TempDirectory {
+    private:
+        std::filesystem::path path;
+    public:
+        TempDirectory() {
+            std::string pattern = (std::filesystem::temp_directory_path() / "cmt_test_XXXXXX").string();
+            if (mkdtemp(pattern.data()) != nullptr) path = pattern;
+        }
+        ~TempDirectory() {
+            std::error_code ec;
+            if (!path.empty()) std::filesystem::remove_all(path, ec);
+        }
+        TempDirectory(const TempDirectory&) = delete;
+        TempDirectory& operator=(const TempDirectory&) = delete;
+
+        std::string file(const std::string& name) const { return (path / name).string(); }
+        const std::filesystem::path& directory() const { return path; }
+    };
+
+    // One feature in the techniques.json layout.
+    inline nlohmann::json feature(const std::string& id, const std::string& name, const std::string& definition,
+                                  std::vector<std::string> useCases = {}) {
+        return {
+            {"id", id},
+            {"name", name},
+            {"definition", definition},
+            {"primary_use_cases", std::move(useCases)},
+            {"syntax", {{"basic", name + "();"}}},
+            {"complete_demo", {{"code", "int main() { return 0; }"}, {"expected_output", ""}}},
+        };
+    }
+
+    // A catalog document: sections given as {key, version, features}, e.g.
+    // {"cpp17_features", "C++17", {...}}, plus optional metadata.
+    struct Section {
+        std::string key;
+        std::string version;
+        std::vector<nlohmann::json> features;
+    };
+
+    inline nlohmann::json catalog(const std::vector<Section>& sections, nlohmann::json metadata = nlohmann::json::object()) {
+        nlohmann::json root = {{"metadata", std::move(metadata)}};
+        for (const auto& section : sections) {
+            root[section.key] = {{"version", section.version}, {"features", section.features}};
+        }
+        return {{"cpp_modern_features", std::move(root)}};
+    }
+
+    inline void writeFile(const std::string& path, const std::string& text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+
+    inline void writeJson(const std::string& path, const nlohmann::json& document) {
+        writeFile(path, document.dump(2));
+    }
+}
+
+#define CHECK(condition)                                                                    \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            ++TestSupport::failures;                                                        \
+        }                                                                                   \
+    } while (0)
+
+#endif // TESTSUPPORT_H
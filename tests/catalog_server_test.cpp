@@ -0,0 +1,118 @@
+#include "TestSupport.h"
+#include "technique/Header/CatalogServer.h"
+#include <chrono>
+#include <csignal>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using TestSupport::feature;
+
+namespace {
+    int connectTo(const std::string& path) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+        for (int attempt = 0; attempt < 200; ++attempt) {
+            int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+            if (fd >= 0) close(fd);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return -1;
+    }
+
+    void send(int fd, const std::string& text) {
+        for (size_t sent = 0; sent < text.size();) {
+            ssize_t n = ::send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    // Every reply line until the server closes the connection.
+    std::vector<nlohmann::json> readReplies(int fd) {
+        std::string text;
+        char buffer[4096];
+        for (ssize_t n; (n = recv(fd, buffer, sizeof(buffer), 0)) > 0;) text.append(buffer, static_cast<size_t>(n));
+        close(fd);
+        std::vector<nlohmann::json> replies;
+        for (size_t start = 0, end; (end = text.find('\n', start)) != std::string::npos; start = end + 1) {
+            replies.push_back(nlohmann::json::parse(text.substr(start, end - start), nullptr, false));
+        }
+        return replies;
+    }
+
+    nlohmann::json withDemo(nlohmann::json item, const std::string& code) {
+        item["complete_demo"] = {{"code", code}};
+        return item;
+    }
+}
+
+// The line protocol over a Unix socket: pipelined replies in request order,
+// errors for bad requests, the line length limit, and a shutdown that
+// answers queued RUN requests with an error instead of running them.
+int main() {
+    TestSupport::TempDirectory temp;
+    setenv("CMT_DEMO_CACHE_DIR", temp.file("cache").c_str(), 1);
+    std::string path = temp.file("techniques.json");
+    TestSupport::writeJson(path, TestSupport::catalog({
+        {"cpp17_features", "C++17", {withDemo(feature("alpha", "Alpha", "Folds a parameter pack."),
+                                              "#include <iostream>\nint main() { std::cout << \"hi\"; }\n")}},
+        {"cpp20_features", "C++20", {withDemo(feature("beta", "Beta", "Sleeps for a while."),
+                                              "#include <thread>\nint main() { std::this_thread::sleep_for(std::chrono::seconds(1)); }\n")}},
+    }));
+    TechniqueManager manager;
+    CHECK(manager.loadFromJson(path));
+
+    std::string address = temp.file("server.sock");
+    CatalogServer server(manager, address, false, 1);
+    bool served = false;
+    std::string errors;
+    std::thread loop([&] { served = server.run(errors); });
+
+    int fd = connectTo(address);
+    CHECK(fd >= 0);
+    send(fd, "LIST\nDETAIL 1\nDETAIL 9\n\nSEARCH folds\nfrobnicate\nRUN 0\ndetail 0\nQUIT\n");
+    auto replies = readReplies(fd);
+    CHECK(replies.size() == 7);
+    if (replies.size() == 7) {
+        CHECK(replies[0]["ok"] == true && replies[0]["techniques"].size() == 2);
+        CHECK(replies[0]["techniques"][1]["name"] == "Beta");
+        CHECK(replies[1]["name"] == "Beta" && replies[1]["cpp_version"] == "C++20");
+        CHECK(replies[2]["ok"] == false && replies[2]["error"] == "expected an index below 2");
+        CHECK(replies[3]["hits"].size() == 1 && replies[3]["hits"][0]["name"] == "Alpha");
+        CHECK(replies[4]["error"] == "unknown command: FROBNICATE");
+        CHECK(replies[5]["compiled"] == true && replies[5]["output"] == "hi");
+        CHECK(replies[6]["name"] == "Alpha");
+    }
+
+    fd = connectTo(address);
+    send(fd, std::string(CatalogServer::MAX_LINE + 1, 'x'));
+    replies = readReplies(fd);
+    CHECK(replies.size() == 1 && replies[0]["error"] == "request line too long");
+
+    // One worker: one RUN is running when SIGTERM arrives, the other two are
+    // still queued and must be answered, in order, without compiling.
+    fd = connectTo(address);
+    send(fd, "RUN 1\nRUN 1\nRUN 1\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    kill(getpid(), SIGTERM);
+    replies = readReplies(fd);
+    loop.join();
+    CHECK(served);
+    CHECK(replies.size() == 3);
+    size_t ran = 0;
+    size_t cancelled = 0;
+    for (const auto& reply : replies) {
+        if (reply.value("ok", false)) ++ran;
+        else if (reply.value("error", "").find("shutting down") != std::string::npos) ++cancelled;
+    }
+    CHECK(ran == 1);
+    CHECK(cancelled == 2);
+    CHECK(!std::filesystem::exists(address));
+    std::cerr << errors;
+
+    return TestSupport::result();
+}
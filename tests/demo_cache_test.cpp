@@ -0,0 +1,72 @@
+#include "TestSupport.h"
+#include "technique/Header/DemoCache.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::string readFile(const fs::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+}
+
+// Cache keys, hit accounting, LRU eviction and the sweep of abandoned
+// staging files. Entries are plain files here; nothing is compiled.
+int main() {
+    TestSupport::TempDirectory temp;
+    fs::path directory = temp.directory() / "cache";
+    DemoCache cache(directory, 100);
+
+    std::string key = cache.key("int main() {}", "-std=c++23", "g++");
+    CHECK(key.size() == 64);
+    CHECK(key == cache.key("int main() {}", "-std=c++23", "g++"));
+    CHECK(key != cache.key("int main() { }", "-std=c++23", "g++"));
+    CHECK(key != cache.key("int main() {}", "-std=c++20", "g++"));
+    // Pieces are length-prefixed: moving bytes between them changes the key.
+    CHECK(cache.key("ab", "c", "g++") != cache.key("a", "bc", "g++"));
+
+    fs::path binary = temp.file("demo.bin");
+    fs::path fetched = temp.file("fetched.bin");
+    TestSupport::writeFile(binary.string(), std::string(60, 'a'));
+    CHECK(!cache.fetch(key, fetched));
+    CHECK(!fs::exists(fetched));
+    CHECK(cache.hits() == 0 && cache.misses() == 1);
+
+    CHECK(cache.store(key, binary));
+    CHECK(cache.fetch(key, fetched));
+    CHECK(readFile(fetched) == std::string(60, 'a'));
+    CHECK(cache.hits() == 1);
+
+    // A hit that cannot be materialized is a miss.
+    CHECK(!cache.fetch(key, temp.directory() / "missing" / "demo.bin"));
+    CHECK(cache.hits() == 1 && cache.misses() == 2);
+
+    // Over the 100-byte cap the least recently used entry goes first.
+    fs::path entry = directory / (key + ".out");
+    fs::last_write_time(entry, fs::file_time_type::clock::now() - std::chrono::hours(1));
+    std::string second = cache.key("second", "-std=c++23", "g++");
+    TestSupport::writeFile(binary.string(), std::string(60, 'b'));
+    CHECK(cache.store(second, binary));
+    CHECK(!fs::exists(entry));
+    CHECK(fs::exists(directory / (second + ".out")));
+    CHECK(cache.evictions() == 1);
+
+    // Replacing an entry does not count its old size twice.
+    CHECK(cache.store(second, binary));
+    CHECK(fs::exists(directory / (second + ".out")));
+    CHECK(cache.evictions() == 1);
+
+    // Staging files are swept once they are old enough to be abandoned.
+    fs::path stale = directory / (key + DemoCache::STAGING_MARKER + "1.2");
+    fs::path fresh = directory / (second + DemoCache::STAGING_MARKER + "3.4");
+    TestSupport::writeFile(stale.string(), "x");
+    TestSupport::writeFile(fresh.string(), "y");
+    fs::last_write_time(stale, fs::file_time_type::clock::now() - DemoCache::STALE_STAGING_AGE - std::chrono::minutes(1));
+    DemoCache reopened(directory, 100);
+    reopened.evict();
+    CHECK(!fs::exists(stale));
+    CHECK(fs::exists(fresh));
+    CHECK(fs::exists(directory / (second + ".out")));
+
+    return TestSupport::result();
+}
@@ -0,0 +1,101 @@
+#include "TestSupport.h"
+#include "technique/Header/LazyJsonCatalog.h"
+#include "technique/Header/TechniqueManager.h"
+
+using TestSupport::feature;
+
+namespace {
+    void checkSame(const ICatalog& lazy, const ICatalog& eager) {
+        CHECK(lazy.size() == eager.size());
+        for (size_t i = 0; i < std::min(lazy.size(), eager.size()); ++i) {
+            CHECK(lazy.name(i) == eager.name(i));
+            CHECK(lazy.cppVersion(i) == eager.cppVersion(i));
+            const Technique& a = eager.technique(i);
+            const Technique& b = lazy.technique(i);
+            CHECK(b.getName() == a.getName());
+            CHECK(b.getDefinition() == a.getDefinition());
+            CHECK(b.getUsage() == a.getUsage());
+            CHECK(b.getSyntax() == a.getSyntax());
+            CHECK(b.getDemoCode() == a.getDemoCode());
+            CHECK(b.getCppVersion() == a.getCppVersion());
+            CHECK(b.getNotes() == a.getNotes());
+            CHECK(b.getDemoNote() == a.getDemoNote());
+            CHECK(b.getExpectedOutput() == a.getExpectedOutput());
+            CHECK(b.getUseCases() == a.getUseCases());
+            CHECK(b.getBestPractices() == a.getBestPractices());
+            CHECK(b.getAdvantages() == a.getAdvantages());
+        }
+    }
+
+    void checkAgainstEager(const std::string& path) {
+        LazyJsonCatalog lazy;
+        TechniqueManager eager;
+        CHECK(lazy.open(path));
+        CHECK(eager.loadFromJson(path));
+        if (eager.getCatalog()) checkSame(lazy, *eager.getCatalog());
+    }
+}
+
+// The lazy loader indexes byte ranges in a SAX pass and parses each feature
+// from the mapping on demand; it must agree with the eager loader.
+// argv[1] is techniques.json.
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <techniques.json>\n";
+        return 2;
+    }
+    checkAgainstEager(argv[1]);
+
+    TestSupport::TempDirectory temp;
+    // Braces, quotes and escapes inside strings must not move the ranges;
+    // sections out of standard order are sorted like the eager loader does;
+    // an empty section and non-section members are skipped.
+    nlohmann::json tricky = feature("braces", "Has { and } and \"quotes\" \\\\ in it", "", {"a}b", "{{"});
+    tricky["syntax"] = "struct S { int x{}; };\n// \"}\" \\\\ \\u00e9";
+    std::string edge = temp.file("edge.json");
+    TestSupport::writeJson(edge, TestSupport::catalog({
+        {"cpp20_features", "C++20", {tricky, feature("unicode", "Kỹ thuật é", "")}},
+        {"cpp11_features", "C++11", {}},
+        {"cpp17_features", "C++17", {feature("first", "First", "")}},
+    }, {{"notes", {{"features", "not a section"}}}}));
+    checkAgainstEager(edge);
+
+    // The last feature ends at the last bytes of the file.
+    std::string compact = temp.file("compact.json");
+    TestSupport::writeFile(compact, TestSupport::catalog({{"cpp17_features", "C++17", {feature("only", "Only", "")}}}).dump());
+    checkAgainstEager(compact);
+
+    LazyJsonCatalog rejected;
+    TestSupport::writeFile(temp.file("other.json"), "{\"something_else\": {}}");
+    CHECK(!rejected.open(temp.file("other.json")));
+    TestSupport::writeFile(temp.file("broken.json"), "{\"cpp_modern_features\": {\"cpp17_features\": ");
+    CHECK(!rejected.open(temp.file("broken.json")));
+    CHECK(!rejected.open(temp.file("missing.json")));
+
+    // A member of the wrong type only fails when that feature is opened.
+    nlohmann::json wrongType = feature("wrong", "Wrong", "");
+    wrongType["primary_use_cases"] = 42;
+    std::string typed = temp.file("typed.json");
+    TestSupport::writeJson(typed, TestSupport::catalog({{"cpp17_features", "C++17", {wrongType, feature("fine", "Fine", "")}}}));
+    LazyJsonCatalog partial;
+    CHECK(partial.open(typed));
+    CHECK(partial.size() == 2);
+    CHECK(partial.technique(0).getDefinition().find("Cannot load this feature") == 0);
+    CHECK(partial.technique(1).getName() == "Fine");
+
+    // Truncating the file in place must not fault on the unparsed features.
+    std::string shrinking = temp.file("shrinking.json");
+    std::filesystem::copy_file(argv[1], shrinking);
+    LazyJsonCatalog mapped;
+    CHECK(mapped.open(shrinking));
+    CHECK(mapped.size() > 1);
+    std::string parsedBefore = mapped.technique(0).getDefinition();
+    std::filesystem::resize_file(shrinking, 0);
+    CHECK(mapped.technique(0).getDefinition() == parsedBefore);
+    if (mapped.size() > 1) {
+        CHECK(mapped.technique(mapped.size() - 1).getDefinition().find("changed on disk") != std::string::npos);
+        CHECK(mapped.name(mapped.size() - 1).size() > 0);
+    }
+
+    return TestSupport::result();
+}
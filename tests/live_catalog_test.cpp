@@ -0,0 +1,99 @@
+#include "TestSupport.h"
+#include "technique/Header/CatalogWatcher.h"
+#include "technique/Header/LiveCatalog.h"
+#include "technique/Header/TechniqueManager.h"
+#include <chrono>
+#include <thread>
+
+using TestSupport::feature;
+
+// Per-feature diffing on reload: unchanged features keep their Technique
+// object, edited and added ones are parsed, and a broken file leaves the
+// published catalog alone.
+int main() {
+    TestSupport::TempDirectory temp;
+    std::string path = temp.file("techniques.json");
+    TestSupport::writeJson(path, TestSupport::catalog({
+        {"cpp17_features", "C++17", {feature("a", "Alpha", "First."), feature("b", "Beta", "Second.")}},
+        {"cpp20_features", "C++20", {feature("c", "Gamma", "Third.")}},
+    }));
+
+    LiveCatalog first;
+    CatalogDiff diff;
+    CHECK(first.load(path, nullptr, &diff));
+    CHECK(first.size() == 3);
+    CHECK(diff.added == 3 && diff.changed == 0 && diff.removed == 0 && diff.unchanged == 0);
+    CHECK(first.id(2) == "c");
+    CHECK(first.cppVersion(2) == "C++20");
+
+    // Edit b, drop c, add d, keep a.
+    TestSupport::writeJson(path, TestSupport::catalog({
+        {"cpp17_features", "C++17", {feature("a", "Alpha", "First."), feature("b", "Beta", "Second, edited.")}},
+        {"cpp20_features", "C++20", {feature("d", "Delta", "Fourth.")}},
+    }));
+    LiveCatalog second;
+    CHECK(second.load(path, &first, &diff));
+    CHECK(diff.added == 1);
+    CHECK(diff.changed == 1);
+    CHECK(diff.removed == 1);
+    CHECK(diff.unchanged == 1);
+    CHECK(second.size() == 3);
+    CHECK(&second.technique(0) == &first.technique(0));
+    CHECK(&second.technique(1) != &first.technique(1));
+    CHECK(second.technique(1).getDefinition() == "Second, edited.");
+    CHECK(second.id(2) == "d");
+
+    // Moving a feature to another version section changes its content.
+    TestSupport::writeJson(path, TestSupport::catalog({
+        {"cpp17_features", "C++17", {feature("b", "Beta", "Second, edited.")}},
+        {"cpp20_features", "C++20", {feature("a", "Alpha", "First."), feature("d", "Delta", "Fourth.")}},
+    }));
+    LiveCatalog third;
+    CHECK(third.load(path, &second, &diff));
+    CHECK(diff.changed == 1 && diff.unchanged == 2 && diff.added == 0 && diff.removed == 0);
+    CHECK(third.technique(1).getCppVersion() == "C++20");
+
+    // Through the manager: a half-written file is a failed reload and the
+    // previous catalog stays published.
+    TechniqueManager manager;
+    CHECK(manager.reloadFromJson(path, &diff));
+    auto published = manager.getCatalog();
+    TestSupport::writeFile(path, "{\"cpp_modern_features\": {\"cpp17_features\": ");
+    CHECK(!manager.reloadFromJson(path, &diff));
+    CHECK(manager.getCatalog() == published);
+    CHECK(manager.size() == 3);
+
+    // Started from the lazy loader (as main does): the first reload diffs
+    // against a baseline LiveCatalog instead of re-parsing every feature.
+    TestSupport::writeJson(path, TestSupport::catalog({
+        {"cpp17_features", "C++17", {feature("a", "Alpha", "First."), feature("b", "Beta", "Second.")}},
+    }));
+    TechniqueManager lazyStart;
+    CHECK(lazyStart.loadFromJsonLazy(path));
+    LiveCatalog baseline;
+    CHECK(baseline.load(path));
+    TestSupport::writeJson(path, TestSupport::catalog({
+        {"cpp17_features", "C++17", {feature("a", "Alpha", "First."), feature("b", "Beta", "Second, edited.")}},
+    }));
+    CHECK(lazyStart.reloadFromJson(path, &diff, &baseline));
+    CHECK(diff.unchanged == 1 && diff.changed == 1 && diff.added == 0);
+    CHECK(&lazyStart.getTechnique(0) == &baseline.technique(0));
+
+    // The watcher publishes a saved edit over a lazily loaded catalog.
+    TechniqueManager watched;
+    CHECK(watched.loadFromJsonLazy(path));
+    CatalogWatcher watcher(watched, path);
+    if (watcher.start()) {
+        TestSupport::writeJson(path, TestSupport::catalog({
+            {"cpp17_features", "C++17", {feature("a", "Alpha", "First."), feature("e", "Epsilon", "Fifth.")}},
+        }));
+        for (int i = 0; i < 200 && watcher.reloadCount() == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        CHECK(watcher.reloadCount() == 1);
+        CHECK(watched.nameAt(1) == "Epsilon");
+        CHECK(dynamic_cast<const LiveCatalog*>(watched.getCatalog().get()) != nullptr);
+    }
+
+    return TestSupport::result();
+}
@@ -0,0 +1,76 @@
+#include "TestSupport.h"
+#include "Process.h"
+#include <csignal>
+
+namespace {
+    // The hex signal set on a line of /proc/self/status as seen by a child, e.g. "SigIgn".
+    unsigned long long childSignalSet(const std::string& field) {
+        ProcessResult result = Process::run({"grep", field + ":", "/proc/self/status"});
+        size_t colon = result.out.find(':');
+        if (!result.succeeded() || colon == std::string::npos) return ~0ULL;
+        return std::stoull(result.out.substr(colon + 1), nullptr, 16);
+    }
+}
+
+// Process::run: exit status, stdin/stdout plumbing, deadlines (also after
+// the child closed its pipes), the output cap, and the signal state a child
+// inherits.
+int main() {
+    ProcessOptions withInput;
+    withInput.input = "hello\n";
+    ProcessResult echo = Process::run({"sh", "-c", "cat; echo err >&2; exit 3"}, withInput);
+    CHECK(echo.started);
+    CHECK(echo.exitCode == 3);
+    CHECK(!echo.succeeded());
+    CHECK(echo.out == "hello\n");
+    CHECK(echo.err == "err\n");
+
+    ProcessResult missing = Process::run({"cmt-no-such-command"});
+    CHECK(!missing.started);
+    CHECK(missing.err.find("command not found") != std::string::npos);
+
+    ProcessResult killed = Process::run({"sh", "-c", "kill -TERM $$"});
+    CHECK(killed.termSignal == SIGTERM);
+
+    ProcessOptions limit;
+    limit.timeoutSeconds = 0.3;
+    ProcessResult slow = Process::run({"sleep", "5"}, limit);
+    CHECK(slow.timedOut);
+    CHECK(slow.termSignal == SIGKILL);
+    CHECK(slow.wallSeconds < 2.0);
+
+    // Closing stdout/stderr must not end deadline enforcement.
+    ProcessResult detached = Process::run({"sh", "-c", "exec >&- 2>&-; sleep 5"}, limit);
+    CHECK(detached.timedOut);
+    CHECK(detached.wallSeconds < 2.0);
+    ProcessResult quick = Process::run({"sh", "-c", "exec >&- 2>&-; exit 4"}, limit);
+    CHECK(!quick.timedOut);
+    CHECK(quick.exitCode == 4);
+
+    // A runaway writer is cut off at the cap and killed.
+    ProcessOptions capped;
+    capped.outputLimit = 4096;
+    capped.timeoutSeconds = 5.0;
+    ProcessResult flood = Process::run({"yes"}, capped);
+    CHECK(flood.truncated);
+    CHECK(flood.out.size() == 4096);
+    CHECK(flood.termSignal == SIGKILL);
+    CHECK(flood.wallSeconds < 2.0);
+
+    // run() ignores SIGPIPE for itself; children get the default back and
+    // an empty signal mask.
+    constexpr unsigned long long SIGPIPE_BIT = 1ULL << (SIGPIPE - 1);
+    std::signal(SIGPIPE, SIG_IGN);
+    CHECK((childSignalSet("SigIgn") & SIGPIPE_BIT) == 0);
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGTERM);
+    sigprocmask(SIG_BLOCK, &blocked, &previous);
+    CHECK(childSignalSet("SigBlk") == 0);
+    sigprocmask(SIG_SETMASK, &previous, nullptr);
+
+    CHECK(!Process::findExecutable("sh").empty());
+    CHECK(Process::findExecutable("cmt-no-such-command").empty());
+
+    return TestSupport::result();
+}
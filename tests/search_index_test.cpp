@@ -0,0 +1,102 @@
+#include "TestSupport.h"
+#include "technique/Header/LazyJsonCatalog.h"
+#include "technique/Header/SearchIndex.h"
+#include "technique/Header/TechniqueManager.h"
+#include "technique/Header/VectorCatalog.h"
+
+namespace {
+    Technique make(const std::string& name, const std::string& definition, std::vector<std::string> useCases = {},
+                   const std::string& code = "") {
+        return Technique(name, definition, "", "", code, "C++20", "", "", std::move(useCases));
+    }
+
+    // Index of the catalog entry named name among hits, or hits.size() if absent.
+    size_t rankOf(const std::vector<SearchHit>& hits, const ICatalog& catalog, std::string_view name) {
+        for (size_t i = 0; i < hits.size(); ++i) {
+            if (catalog.name(hits[i].index) == name) return i;
+        }
+        return hits.size();
+    }
+}
+
+// Ranking of the inverted index: field weights, query coverage, prefix and
+// typo-tolerant matches, the cap on prefix expansions, and indexing a lazy
+// catalog through visitText. argv[1] is techniques.json.
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <techniques.json>\n";
+        return 2;
+    }
+    std::vector<Technique> techniques;
+    techniques.push_back(make("Ranges", "Composable views over sequences.", {"Lazy pipelines"}));
+    techniques.push_back(make("Coroutines", "Functions that can suspend and resume.", {"Generators", "Async tasks"}));
+    techniques.push_back(make("Concepts", "Named constraints on template parameters.", {"Constraining templates"}));
+    techniques.push_back(make("std::generator", "A coroutine type producing a lazy sequence.", {"Lazy pipelines"}));
+    techniques.push_back(make("Modules", "Replace headers.", {}, "co_await coroutines_are_not_used_here();"));
+    VectorCatalog catalog(std::move(techniques));
+    SearchIndex index;
+    index.build(catalog);
+    CHECK(index.termCount() > 0);
+
+    // A name match outranks a definition match, which outranks demo code.
+    auto hits = index.search("coroutine");
+    CHECK(rankOf(hits, catalog, "Coroutines") == 0);
+    CHECK(rankOf(hits, catalog, "std::generator") < hits.size());
+    for (size_t i = 1; i < hits.size(); ++i) CHECK(hits[i - 1].score >= hits[i].score);
+
+    // Every query word matched beats a better match on only one of them.
+    hits = index.search("lazy sequence");
+    CHECK(rankOf(hits, catalog, "std::generator") == 0);
+    CHECK(rankOf(hits, catalog, "Ranges") < hits.size());
+
+    // Prefixes and small typos still find the feature.
+    CHECK(rankOf(index.search("corout"), catalog, "Coroutines") == 0);
+    CHECK(rankOf(index.search("concpets"), catalog, "Concepts") == 0);
+    CHECK(rankOf(index.search("CONCEPTS"), catalog, "Concepts") == 0);
+
+    CHECK(index.search("").empty());
+    CHECK(index.search("zzzzqqq").empty());
+    CHECK(index.search("coroutine", 1).size() == 1);
+
+    // A short prefix shared by many terms scores at most MAX_PREFIX_EXPANSIONS of them.
+    std::vector<Technique> many;
+    for (int i = 0; i < 100; ++i) many.push_back(make("Feature " + std::to_string(i), "pre" + std::to_string(1000 + i)));
+    VectorCatalog manyCatalog(std::move(many));
+    SearchIndex manyIndex;
+    manyIndex.build(manyCatalog);
+    size_t expanded = manyIndex.search("pre", 1000).size();
+    CHECK(expanded > 0);
+    CHECK(expanded <= 64);
+
+    // Two adjacent transpositions are two edits but break eight trigrams.
+    std::vector<Technique> swapped;
+    swapped.push_back(make("Swapped", "abcdefghijkl"));
+    VectorCatalog swappedCatalog(std::move(swapped));
+    SearchIndex swappedIndex;
+    swappedIndex.build(swappedCatalog);
+    CHECK(swappedIndex.search("abdcefghjikl").size() == 1);
+
+    // The lazy catalog feeds the index its raw text and must rank like the eager one.
+    LazyJsonCatalog lazy;
+    TechniqueManager eager;
+    CHECK(lazy.open(argv[1]));
+    CHECK(eager.loadFromJson(argv[1]));
+    SearchIndex lazyIndex;
+    SearchIndex eagerIndex;
+    lazyIndex.build(lazy);
+    if (eager.getCatalog()) eagerIndex.build(*eager.getCatalog());
+    CHECK(lazyIndex.termCount() == eagerIndex.termCount());
+    for (const char* query : {"lambda", "coroutine generator", "constexpr", "lamda"}) {
+        auto a = lazyIndex.search(query);
+        auto b = eagerIndex.search(query);
+        CHECK(a.size() == b.size());
+        for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) CHECK(a[i].index == b[i].index);
+    }
+
+    CHECK(SearchIndex::tokenize("Hello, std::vector_v2!") == (std::vector<std::string>{"hello", "std", "vector_v2"}));
+    CHECK(SearchIndex::editDistance("kitten", "sitting", 3) == 3);
+    CHECK(SearchIndex::editDistance("concepts", "concpets", 2) == 1);
+    CHECK(SearchIndex::editDistance("abc", "abcdef", 2) == 3);
+
+    return TestSupport::result();
+}
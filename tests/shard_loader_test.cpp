@@ -0,0 +1,115 @@
+#include "TestSupport.h"
+#include "technique/Header/CatalogWatcher.h"
+#include "technique/Header/ShardLoader.h"
+#include "technique/Header/TechniqueManager.h"
+#include "technique/Header/TechniqueParser.h"
+#include <chrono>
+#include <thread>
+
+using TestSupport::feature;
+
+namespace {
+    std::vector<std::string> namesOf(const std::vector<Technique>& techniques) {
+        std::vector<std::string> names;
+        for (const auto& technique : techniques) names.push_back(technique.getName());
+        return names;
+    }
+}
+
+// Shard merging: section order, path order, and the priority rule for
+// duplicate ids, independent of how many threads parse the shards; reloading
+// a shard set diffs it like a single file.
+int main() {
+    CHECK(TechniqueParser::standardYear("cpp17_features") == 2017);
+    CHECK(TechniqueParser::standardYear("cpp98") == 1998);
+    CHECK(TechniqueParser::standardYear("cpp2c_features") == 2026);
+    CHECK(TechniqueParser::standardYear("cpp1z") == 2017);
+    CHECK(TechniqueParser::standardYear("-std=gnu++2b") == 2023);
+    CHECK(TechniqueParser::standardYear("cpp2026") == 2026);
+    CHECK(TechniqueParser::standardYear("metadata") == 0);
+    CHECK(TechniqueParser::sectionBefore("cpp23_features", "cpp2c_features"));
+    CHECK(!TechniqueParser::sectionBefore("cpp2c_features", "cpp17_features"));
+    CHECK(TechniqueParser::sectionBefore("cpp26_features", "extras"));
+
+    TestSupport::TempDirectory temp;
+    using Section = TestSupport::Section;
+    TestSupport::writeJson(temp.file("a.json"), TestSupport::catalog({
+        Section{"cpp17_features", "C++17", {feature("x", "X from a", ""), feature("y", "Y from a", "")}},
+        Section{"cpp20_features", "C++20", {feature("z", "Z from a", "")}},
+    }));
+    // Higher priority: wins y although a lower-priority shard sorts after it.
+    TestSupport::writeJson(temp.file("b.json"), TestSupport::catalog({
+        Section{"cpp17_features", "C++17", {feature("y", "Y from b", "")}},
+        Section{"cpp20_features", "C++20", {feature("w", "W from b", "")}},
+    }, {{"priority", 5}}));
+    // Same priority as a: the later path wins x and takes x's slot.
+    TestSupport::writeJson(temp.file("c.json"), TestSupport::catalog({
+        Section{"cpp26_features", "C++26", {feature("v", "V from c", "")}},
+        Section{"cpp17_features", "C++17", {feature("x", "X from c", ""), feature("y", "Y from c", "")}},
+    }));
+    TestSupport::writeFile(temp.file("notes.txt"), "not a shard");
+
+    std::string directory = temp.directory().string();
+    CHECK(ShardLoader::isShardSet(directory));
+    CHECK(ShardLoader::isShardSet(directory + "/*.json"));
+    CHECK(!ShardLoader::isShardSet(temp.file("a.json")));
+
+    std::vector<std::string> shards = ShardLoader::expand(directory);
+    CHECK(shards == (std::vector<std::string>{temp.file("a.json"), temp.file("b.json"), temp.file("c.json")}));
+    CHECK(ShardLoader::expand(directory + "/[ab].json").size() == 2);
+
+    const std::vector<std::string> expected = {"X from c", "Y from b", "Z from a", "W from b", "V from c"};
+    for (size_t threads : {1, 4}) {
+        std::vector<Technique> techniques;
+        ShardLoadReport report;
+        CHECK(ShardLoader::load(shards, techniques, report, threads));
+        CHECK(namesOf(techniques) == expected);
+        CHECK(report.shards == 3);
+        CHECK(report.features == 5);
+        CHECK(report.duplicates == 3);
+        CHECK(report.errors.empty());
+    }
+
+    TechniqueManager manager;
+    ShardLoadReport report;
+    CHECK(manager.loadFromShards(directory, report));
+    CHECK(manager.size() == expected.size());
+    CHECK(manager.nameAt(0) == "X from c");
+    CHECK(manager.versionAt(4) == "C++26");
+
+    // Editing one shard re-parses only what changed in the merged result.
+    const Technique* keptX = &manager.getTechnique(0);
+    TestSupport::writeJson(temp.file("b.json"), TestSupport::catalog({
+        Section{"cpp17_features", "C++17", {feature("y", "Y from b", "")}},
+        Section{"cpp20_features", "C++20", {feature("w", "W from b, edited", "")}},
+    }, {{"priority", 5}}));
+    CatalogDiff diff;
+    CHECK(manager.loadFromShards(directory, report, &diff));
+    CHECK(diff.changed == 1 && diff.unchanged == 4 && diff.added == 0 && diff.removed == 0);
+    CHECK(&manager.getTechnique(0) == keptX);
+    CHECK(manager.nameAt(3) == "W from b, edited");
+
+    // One unreadable shard fails the whole load and leaves the output alone.
+    TestSupport::writeFile(temp.file("d.json"), "{ broken");
+    std::vector<Technique> untouched = {Technique("keep", "", "", "", "")};
+    CHECK(!ShardLoader::load(ShardLoader::expand(directory), untouched, report));
+    CHECK(namesOf(untouched) == std::vector<std::string>{"keep"});
+    CHECK(report.errors.find("d.json") != std::string::npos);
+    CHECK(!manager.loadFromShards(temp.file("missing") + "/*.json", report));
+    CHECK(manager.size() == expected.size());
+
+    // The watcher keeps the shard errors of a failed reload.
+    std::filesystem::remove(temp.file("d.json"));
+    CatalogWatcher watcher(manager, directory);
+    if (watcher.start()) {
+        TestSupport::writeFile(temp.file("e.json"), "{ broken");
+        for (int i = 0; i < 200 && watcher.failureCount() == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        CHECK(watcher.failureCount() == 1);
+        CHECK(watcher.lastErrors().find("e.json") != std::string::npos);
+        CHECK(manager.size() == expected.size());
+    }
+
+    return TestSupport::result();
+}
@@ -0,0 +1,68 @@
+#include "TestSupport.h"
+#include "technique/Header/SnapshotCatalog.h"
+#include "technique/Header/TechniqueManager.h"
+#include <algorithm>
+
+// Round-trips a catalog through the binary snapshot: every field and list
+// must come back unchanged, and editing the source JSON must make the
+// snapshot stale. argv[1] is the catalog to use (techniques.json).
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <techniques.json>\n";
+        return 2;
+    }
+    TestSupport::TempDirectory temp;
+    std::string json = temp.file("techniques.json");
+    std::string snapshot = TechniqueManager::snapshotPathFor(json);
+    std::filesystem::copy_file(argv[1], json);
+
+    TechniqueManager source;
+    CHECK(source.loadFromJson(json));
+    auto expected = source.getCatalog();
+    CHECK(expected && expected->size() > 0);
+    if (!expected) return TestSupport::result();
+    CHECK(SnapshotCatalog::write(*expected, snapshot, json));
+
+    SnapshotCatalog loaded;
+    CHECK(loaded.open(snapshot, json));
+    CHECK(loaded.verifyBlob());
+    CHECK(loaded.size() == expected->size());
+    for (size_t i = 0; i < std::min(loaded.size(), expected->size()); ++i) {
+        const Technique& a = expected->technique(i);
+        const Technique& b = loaded.technique(i);
+        CHECK(loaded.name(i) == a.getName());
+        CHECK(loaded.cppVersion(i) == a.getCppVersion());
+        CHECK(b.getName() == a.getName());
+        CHECK(b.getDefinition() == a.getDefinition());
+        CHECK(b.getUsage() == a.getUsage());
+        CHECK(b.getSyntax() == a.getSyntax());
+        CHECK(b.getDemoCode() == a.getDemoCode());
+        CHECK(b.getCppVersion() == a.getCppVersion());
+        CHECK(b.getNotes() == a.getNotes());
+        CHECK(b.getDemoNote() == a.getDemoNote());
+        CHECK(b.getExpectedOutput() == a.getExpectedOutput());
+        CHECK(b.getUseCases() == a.getUseCases());
+        CHECK(b.getBestPractices() == a.getBestPractices());
+        CHECK(b.getAdvantages() == a.getAdvantages());
+    }
+
+    TechniqueManager mapped;
+    CHECK(mapped.loadFromSnapshot(snapshot, json));
+    CHECK(mapped.size() == expected->size());
+
+    // Any edit to the JSON invalidates the snapshot; loadCatalog falls back to the JSON.
+    { std::ofstream(json, std::ios::app) << "\n"; }
+    SnapshotCatalog stale;
+    CHECK(!stale.open(snapshot, json));
+    TechniqueManager fallback;
+    CHECK(!fallback.loadFromSnapshot(snapshot, json));
+    CHECK(fallback.loadCatalog(json));
+    CHECK(fallback.size() == expected->size());
+
+    // A damaged file is rejected rather than mapped.
+    TestSupport::writeFile(snapshot, "CMTCAT truncated");
+    SnapshotCatalog corrupt;
+    CHECK(!corrupt.open(snapshot, ""));
+
+    return TestSupport::result();
+}